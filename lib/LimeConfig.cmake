@@ -45,6 +45,9 @@ if( WIN32 )
 endif()
 find_package( Eigen3 REQUIRED )
 
+# find the thread library (used by the ThreadPool)
+find_package( Threads REQUIRED )
+
 # set the include dir
 set( Lime_INCLUDE_DIR "${Lime_DIR}/include")
 
@@ -77,7 +80,8 @@ set( Lime_INCLUDE_DIRS
 # link libraries
 set( Lime_LINK_LIBRARIES
     -lm
-    -lc CACHE INTERNAL "all libs lime needs" )
+    -lc
+    ${CMAKE_THREAD_LIBS_INIT} CACHE INTERNAL "all libs lime needs" )
 
 
 # enable C++11 support
@@ -0,0 +1,301 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstdlib>
+#include <lime/Segmentation.hpp>
+#include <lime/ColorimetricHSIAlgorithm1.hpp>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <lime/ColorimetricHSVAlgorithm1.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+typedef unsigned char NumType;
+
+// Makes the single steps of an algorithm callable from the benchmark (they are protected)
+template<class A> class Probe : public A
+{
+
+public:
+
+	CImg<double>* transform(const CImg<NumType> &img) { return this->transformImage(img); }
+	bool thresholds(double c1, double c2, double c3) { return this->skinThresholds(c1, c2, c3); }
+
+	void classify(const CImg<NumType> &img, CImg<bool> &mask)
+	{
+		this->prepareClassification();
+
+		for (int y = 0; y < img.height(); y++)
+		{
+			this->classifyPixels(img.data(0,y,0,0), img.data(0,y,0,1), img.data(0,y,0,2), img.width(), mask.data(0,y,0,0));
+		}
+	}
+
+	void label(const CImg<bool> &mask) { this->labelRegions(mask); }
+	void grow(CImg<bool> *mask, unsigned int count, unsigned int size) { this->growAlgorithm(mask, count, size); }
+	void shrink(CImg<bool> *mask, unsigned int count, unsigned int size) { this->shrinkAlgorithm(mask, count, size); }
+	std::vector<BinarySeed>* seeds(bool skin, const CImg<bool> &mask) { return this->getSeeds(skin, false, mask, false, 1, 3); }
+	CImg<int>* distanceMap(CImg<bool> &mask) { return this->getDistanceMapOfMask(mask, false); }
+	void segment(const CImg<NumType> &img, CImg<bool> &mask) { this->processImage(img, mask); }
+
+};
+
+// A single measurement: the median time of all repetitions of a stage on one image
+struct Result
+{
+	std::string stage;
+	int width;
+	int height;
+	double coverage;
+	double milliseconds;
+};
+
+// Generates an image with a noisy non-skin background and skin colored discs that cover about the given fraction of the pixels
+CImg<NumType> syntheticImage(int width, int height, double coverage, unsigned int seed)
+{
+	std::srand(seed);
+	CImg<NumType> img(width, height, 1, 3);
+
+	cimg_forXY(img,x,y)
+	{
+		img(x,y,0,0) = (NumType)(std::rand() % 90);
+		img(x,y,0,1) = (NumType)(90 + std::rand() % 110);
+		img(x,y,0,2) = (NumType)(120 + std::rand() % 136);
+	}
+
+	CImg<bool> covered(width, height, 1, 1, false);
+	const unsigned long long target = (unsigned long long)(coverage * width * height);
+	unsigned long long count = 0;
+
+	while (count < target)
+	{
+		const int cx = std::rand() % width;
+		const int cy = std::rand() % height;
+		const int r = 4 + std::rand() % std::max(1, std::min(width, height) / 8);
+
+		for (int y = std::max(0, cy - r); y <= std::min(height - 1, cy + r) && count < target; y++)
+		{
+			for (int x = std::max(0, cx - r); x <= std::min(width - 1, cx + r) && count < target; x++)
+			{
+				if ((x - cx) * (x - cx) + (y - cy) * (y - cy) < r * r && !covered(x,y))
+				{
+					covered(x,y) = true;
+					count++;
+					img(x,y,0,0) = (NumType)(180 + std::rand() % 60);
+					img(x,y,0,1) = (NumType)(120 + std::rand() % 40);
+					img(x,y,0,2) = (NumType)(90 + std::rand() % 40);
+				}
+			}
+		}
+	}
+
+	return img;
+}
+
+// Calls setup and then run repetitions times and returns the median time of run in milliseconds (setup is not timed)
+double measure(unsigned int repetitions, const std::function<void()> &setup, const std::function<void()> &run)
+{
+	std::vector<double> times;
+
+	for (unsigned int i = 0; i < repetitions; i++)
+	{
+		setup();
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		run();
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+	}
+
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+// Times transformImage, the skinThresholds loop over the transformed image and the fused classification of an algorithm
+template<class A>
+void benchmarkAlgorithm(const std::string &name, const CImg<NumType> &img, double coverage, unsigned int repetitions, unsigned int threads, std::vector<Result> &results)
+{
+	Probe<A> algo;
+	algo.ThreadCount(threads);
+
+	const std::function<void()> nothing = []{};
+	CImg<double> *transformed = 0;
+	CImg<bool> mask(img.width(), img.height(), 1, 1);
+
+	const Result transform = { name + ".transformImage", img.width(), img.height(), coverage, measure(repetitions, [&]{ delete transformed; transformed = 0; }, [&]{ transformed = algo.transform(img); }) };
+	results.push_back(transform);
+
+	const Result thresholds = { name + ".skinThresholds", img.width(), img.height(), coverage, measure(repetitions, nothing, [&]
+	{
+		cimg_forXY(*transformed,x,y)
+		{
+			mask(x,y) = algo.thresholds((*transformed)(x,y,0,0), (*transformed)(x,y,0,1), (*transformed)(x,y,0,2));
+		}
+	}) };
+	results.push_back(thresholds);
+
+	delete transformed;
+
+	const Result classify = { name + ".classifyRow", img.width(), img.height(), coverage, measure(repetitions, nothing, [&]{ algo.classify(img, mask); }) };
+	results.push_back(classify);
+
+	algo.ApplyLookupTable(true);
+	algo.classify(img, mask);
+
+	const Result lookup = { name + ".lookupTable", img.width(), img.height(), coverage, measure(repetitions, nothing, [&]{ algo.classify(img, mask); }) };
+	results.push_back(lookup);
+}
+
+// Times all stages on one synthetic image
+void benchmarkImage(int width, int height, double coverage, unsigned int repetitions, unsigned int threads, std::vector<Result> &results)
+{
+	const CImg<NumType> img = syntheticImage(width, height, coverage, (unsigned int)(width * 31 + height * 17 + coverage * 1000));
+	const std::function<void()> nothing = []{};
+
+	// Median filter
+	CImg<NumType> filtered;
+	const unsigned int medianSizes[] = { 3, 5, 9 };
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		std::ostringstream stage;
+		stage << "median" << medianSizes[i];
+
+		const Result filter = { stage.str(), width, height, coverage, measure(repetitions, nothing, [&]{ median::blurMedian(img, medianSizes[i], filtered); }) };
+		results.push_back(filter);
+	}
+
+	// Transformations and thresholds of all algorithms
+	benchmarkAlgorithm< ColorimetricYCbCrAlgorithm1<NumType> >("YCbCr", img, coverage, repetitions, threads, results);
+	benchmarkAlgorithm< ColorimetricHSVAlgorithm1<NumType> >("HSV", img, coverage, repetitions, threads, results);
+	benchmarkAlgorithm< ColorimetricHSIAlgorithm1<NumType> >("HSI", img, coverage, repetitions, threads, results);
+
+	// The post-processing steps work on the raw classification of the image
+	Probe< ColorimetricYCbCrAlgorithm1<NumType> > algo;
+	algo.ThreadCount(threads);
+
+	CImg<bool> classified(width, height, 1, 1);
+	algo.classify(img, classified);
+
+	CImg<bool> mask;
+	const std::function<void()> resetMask = [&]{ mask = classified; };
+
+	const Result labeling = { "labelRegions", width, height, coverage, measure(repetitions, nothing, [&]{ algo.label(classified); }) };
+	results.push_back(labeling);
+
+	const Result grow = { "grow", width, height, coverage, measure(repetitions, resetMask, [&]{ algo.grow(&mask, 3, 3); }) };
+	results.push_back(grow);
+
+	const Result shrink = { "shrink", width, height, coverage, measure(repetitions, resetMask, [&]{ algo.shrink(&mask, 3, 3); }) };
+	results.push_back(shrink);
+
+	std::vector<BinarySeed> *skinSeeds = 0, *nonSkinSeeds = 0;
+
+	const Result seedsSkin = { "getSeeds.skin", width, height, coverage, measure(repetitions, [&]{ delete skinSeeds; skinSeeds = 0; }, [&]{ skinSeeds = algo.seeds(true, classified); }) };
+	results.push_back(seedsSkin);
+
+	const Result seedsNonSkin = { "getSeeds.nonSkin", width, height, coverage, measure(repetitions, [&]{ delete nonSkinSeeds; nonSkinSeeds = 0; }, [&]{ nonSkinSeeds = algo.seeds(false, classified); }) };
+	results.push_back(seedsNonSkin);
+
+	CImg<int> *map = 0;
+
+	const Result distanceMap = { "getDistanceMapOfMask", width, height, coverage, measure(repetitions, [&]{ delete map; map = 0; }, [&]{ map = algo.distanceMap(classified); }) };
+	results.push_back(distanceMap);
+
+	// Visualizers of util.hpp
+	CImg<int> *rgbMask = 0;
+	CImg<unsigned char> *visualization = 0;
+	CImg<NumType> fused;
+
+	const Result maskToRGB = { "changeBinaryMaskToRGBImage", width, height, coverage, measure(repetitions, [&]{ delete rgbMask; rgbMask = 0; }, [&]{ rgbMask = changeBinaryMaskToRGBImage(classified); }) };
+	results.push_back(maskToRGB);
+
+	const Result seedsToRGB = { "addSeedsToRGBImage", width, height, coverage, measure(repetitions, nothing, [&]{ addSeedsToRGBImage(rgbMask, skinSeeds, nonSkinSeeds); }) };
+	results.push_back(seedsToRGB);
+
+	const Result mapToGreyscale = { "distanceMapToGreyscale", width, height, coverage, measure(repetitions, [&]{ delete visualization; visualization = 0; }, [&]{ visualization = distanceMapToGreyscale(map); }) };
+	results.push_back(mapToGreyscale);
+
+	const Result mapToRGB = { "distanceMapToRGB", width, height, coverage, measure(repetitions, [&]{ delete visualization; visualization = 0; }, [&]{ visualization = distanceMapToRGB(map); }) };
+	results.push_back(mapToRGB);
+
+	const Result fuse = { "fuseBinaryMaskWithRGBImage", width, height, coverage, measure(repetitions, [&]{ fused = img; }, [&]{ fuseBinaryMaskWithRGBImage(&fused, &classified); }) };
+	results.push_back(fuse);
+
+	delete skinSeeds;
+	delete nonSkinSeeds;
+	delete map;
+	delete rgbMask;
+	delete visualization;
+
+	// The whole pipeline with the configuration of the test app
+	algo.ApplyMedian(true);
+	algo.MedianSize(3);
+	algo.ApplyGrow(true);
+	algo.GrowSize(3);
+	algo.ApplyShrink(true);
+	algo.ApplyRegionClearing(true);
+	algo.ApplyLookupTable(true);
+	algo.segment(img, mask);
+
+	const Result pipeline = { "pipeline", width, height, coverage, measure(repetitions, nothing, [&]{ algo.segment(img, mask); }) };
+	results.push_back(pipeline);
+
+	// The same pipeline with coarse-to-fine classification of 4 x 4 tiles
+	algo.PyramidFactor(4);
+	algo.segment(img, mask);
+
+	const Result pyramid = { "pipeline.pyramid4", width, height, coverage, measure(repetitions, nothing, [&]{ algo.segment(img, mask); }) };
+	results.push_back(pyramid);
+}
+
+// Times every stage of the segmentation on synthetic images of several sizes and skin coverages and writes the results as JSON
+int main(int argc, char** argv)
+{
+	const std::string outputPath = (argc > 1) ? argv[1] : "bench.json";
+	const unsigned int repetitions = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 5;
+	const unsigned int threads = (argc > 3) ? (unsigned int)std::atoi(argv[3]) : 1;
+
+	const int sizes[][2] = { { 320, 240 }, { 640, 480 }, { 1280, 720 }, { 1920, 1080 } };
+	const double coverages[] = { 0.05, 0.25, 0.5 };
+
+	std::vector<Result> results;
+
+	for (unsigned int s = 0; s < 4; s++)
+	{
+		for (unsigned int c = 0; c < 3; c++)
+		{
+			benchmarkImage(sizes[s][0], sizes[s][1], coverages[c], repetitions, threads, results);
+			std::cerr << sizes[s][0] << "x" << sizes[s][1] << " coverage " << coverages[c] << " done" << std::endl;
+		}
+	}
+
+	std::ofstream json(outputPath.c_str());
+	json << std::setprecision(6);
+	json << "{\n  \"version\": \"0.3.0\",\n  \"threads\": " << threads << ",\n  \"repetitions\": " << repetitions << ",\n  \"results\": [\n";
+
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		const Result &r = results[i];
+		const double pixelsPerSecond = (r.milliseconds > 0) ? (double)r.width * r.height / (r.milliseconds / 1000.0) : 0.0;
+
+		json << "    { \"stage\": \"" << r.stage << "\", \"width\": " << r.width << ", \"height\": " << r.height << ", \"coverage\": " << r.coverage
+			<< ", \"ms\": " << r.milliseconds << ", \"pixels_per_second\": " << pixelsPerSecond << " }" << ((i + 1 < results.size()) ? "," : "") << "\n";
+
+		std::cout << std::left << std::setw(28) << r.stage << std::right << std::setw(6) << r.width << "x" << std::setw(5) << r.height
+			<< std::fixed << std::setw(6) << std::setprecision(2) << r.coverage << std::setw(12) << std::setprecision(3) << r.milliseconds << " ms"
+			<< std::setw(10) << std::setprecision(1) << pixelsPerSecond / 1e6 << " MPixel/s" << std::endl;
+		std::cout.unsetf(std::ios::fixed);
+	}
+
+	json << "  ]\n}\n";
+
+	return json ? 0 : 1;
+}
@@ -35,10 +35,17 @@
 #endif
 
 #include <lime/util.hpp>
+#include <lime/ThreadPool.hpp>
+#include <lime/BinaryMask.hpp>
+#include <lime/DistanceTransform.hpp>
+#include <lime/Median.hpp>
+#include <lime/Workspace.hpp>
+#include <lime/Statistics.hpp>
+#include <lime/RegionTable.hpp>
 #include <CImg.h>
 #include <cmath>
-#include <opencv2/opencv.hpp>
-#include <opencv2/flann/flann.hpp>
+#include <cstring>
+#include <memory>
 
 using namespace cimg_library;
 
@@ -54,15 +61,10 @@ namespace lime{
 	///
 	typedef double Threshold;
 
-	///
-	/// @typedef SearchTree
-	/// @brief A generic search tree that is used by the OpenCV FLANN algorithm
-	///
-	typedef cv::flann::GenericIndex<cv::flann::L2_Simple<double> > SearchTree;
-
 #ifndef DOXYGEN_SHOULD_SKIP_THIS // This template forward declaration produces some problems in combination with doxygen so I disabled doxygen for it
 
 	template<typename U> class Segmentation;
+	template<typename U> class StreamSegmentation;
 
 #endif
 
@@ -80,11 +82,29 @@ namespace lime{
 	/// @author Aleander Schoch
 	/// @date Nov 13, 2012 - First creation and implementation
 	/// @date Nov 23, 2012 - Region grow/shrink and region clearing (only the largest region remains) implemented
+	/// @date Oct 16, 2026 - Transformation and thresholds fused into a single pass per row (no intermediate CImg<double>)
+	/// @date Oct 16, 2026 - Optional multi-threaded processing of row bands
+	/// @date Oct 16, 2026 - Region labeling replaced by a linear time two-pass union-find labeling
+	/// @date Oct 16, 2026 - Parallel region labeling of row bands
+	/// @date Oct 16, 2026 - Grow / shrink with van Herk / Gil-Werman filters, repeated kernels collapsed into one
+	/// @date Oct 16, 2026 - Grow / shrink and the seed detection work on bit-packed masks (BinaryMask)
+	/// @date Oct 16, 2026 - Distance map computed with an exact linear time distance transform instead of a FLANN search
+	/// @date Oct 16, 2026 - Distance map computed on the thread pool
+	/// @date Oct 16, 2026 - Classification and post-processing steps available to the front-ends (prepareClassification, classifyPixels, postprocessMask)
+	/// @date Oct 16, 2026 - Non-owning image views (interleaved or planar, any channel order) processed without a copy
+	/// @date Oct 16, 2026 - Constant time histogram median filter for 8-bit images
+	/// @date Oct 16, 2026 - Temporary buffers kept in a workspace across images, masks can be written into a caller-owned CImg
+	/// @date Oct 16, 2026 - Optional per-stage timing and counters of the last call and of all calls
+	/// @date Oct 16, 2026 - Optional coarse-to-fine classification that only filters and refines the tiles near skin or near the decision boundary of a coarse level of tile mean colors
+	/// @date Oct 16, 2026 - Segmentation restricted to regions of interest (rectangles or a prior mask) with the border context of the filters
+	/// @date Oct 16, 2026 - Ordered seeds of the region borders by border following (getContourSeeds)
+	/// @date Oct 16, 2026 - Optional region statistics (area, bounding box, centroid, moments, mean color) accumulated by the region labeling
 	/// @tparam T - Can be of any basic data type and should be the same as the one of the input image (e.g. double or char).
 	///
 	template<typename T = int> class Algorithm{
 
 		friend class Segmentation<T>; ///< Friend declaration of the Segmentation class
+		friend class StreamSegmentation<T>; ///< Friend declaration of the StreamSegmentation class
 
 	public:
 
@@ -96,7 +116,7 @@ namespace lime{
 			unsigned int _fixedGrowShrinkSize = 2, bool _applyGrowBeforeShrink = true, bool _applyRegionClearing = false)
 			:applyMedian(_applyMedian),medianSize(_medianSize), applyGrow(_applyGrow), growCount(_growCount), growSize(_growSize), applyShrink(_applyShrink), shrinkCount(_shrinkCount),
 			shrinkSize(_shrinkSize),applyFixedGrowShrink(_applyFixedGrowShrink), fixedGrowShrinkCount(_fixedGrowShrinkCount), fixedGrowShrinkSize(_fixedGrowShrinkSize), 
-			applyGrowBeforeShrink(_applyGrowBeforeShrink), applyRegionClearing(_applyRegionClearing){}
+			applyGrowBeforeShrink(_applyGrowBeforeShrink), applyRegionClearing(_applyRegionClearing), applyLookupTable(false), applyVectorization(false), lookupTableValid(false), threadCount(1), pyramidFactor(1), pyramidMargin(1), pyramidTolerance(0.0), evaluatedFraction(0.0), collectRegionStatistics(false), collectStatistics(false), recordingStatistics(false){}
 		///
 		/// @brief The destructor of this class.
 		///
@@ -141,17 +161,167 @@ namespace lime{
 		virtual bool ApplyRegionClearing() const { return applyRegionClearing; } ///< Returns if the region clearing algorithm is used (deletes all skin regions but the biggest one).
 		void ApplyRegionClearing(bool val) { applyRegionClearing = val; } ///< Can be used to activate / deactivate the region clearing algorithm (deletes all skin regions but the biggest one).
 
+		virtual bool ApplyLookupTable() const { return applyLookupTable; } ///< Returns if the precomputed RGB lookup table is used for the classification (only meaningful for 8-bit images).
+		virtual void ApplyLookupTable(bool val) { applyLookupTable = val; } ///< Can activate / deactivate the precomputed RGB lookup table (2 MB) which replaces the transformation and the thresholds for 8-bit images.
+
+		virtual bool ApplyVectorization() const { return applyVectorization; } ///< Returns if the single precision SIMD kernels are used for the classification of 8-bit images.
+		virtual void ApplyVectorization(bool val) { applyVectorization = val; invalidateLookupTable(); } ///< Can activate / deactivate the single precision SIMD kernels for 8-bit images (results can differ from the double precision path for colors right on a threshold).
+
+		virtual unsigned int ThreadCount() const { return threadCount; } ///< Returns the number of threads that process an image (1 = serial, 0 = all hardware threads).
+		virtual void ThreadCount(unsigned int val) { threadCount = val; threadPool.reset(); } ///< Can set the number of threads that process an image in row bands (1 = serial, 0 = all hardware threads). The resulting mask is identical to the serial one.
+
+		virtual unsigned int PyramidFactor() const { return pyramidFactor; } ///< Returns the size of the tiles of the coarse-to-fine classification (1 = every pixel is classified).
+		virtual void PyramidFactor(unsigned int val) { pyramidFactor = std::max(1u, val); } ///< Can set the size n of the tiles of the coarse-to-fine classification: the mean colors of the n x n tiles are classified first and only the tiles near skin or near the decision boundary are filtered and classified completely (1 = off). Larger tiles evaluate fewer pixels, but can miss skin regions much smaller than a tile.
+
+		virtual unsigned int PyramidMargin() const { return pyramidMargin; } ///< Returns the number of tiles around a skin tile of the coarse level that are classified completely.
+		virtual void PyramidMargin(unsigned int val) { pyramidMargin = val; } ///< Can set the number of tiles around a skin tile of the coarse level that are classified completely (only meaningful if PyramidFactor > 1). Larger margins find more of the skin at the edges of the regions, but evaluate more pixels.
+
+		virtual Threshold PyramidTolerance() const { return pyramidTolerance; } ///< Returns the distance to the decision boundary (per color channel) within which the tiles of the coarse level are classified completely.
+		virtual void PyramidTolerance(Threshold val) { pyramidTolerance = val; } ///< Can set the distance to the decision boundary within which the tiles of the coarse level are classified completely: a tile is refined if moving a channel of its mean color by this value changes the classification (only meaningful if PyramidFactor > 1, 0 = only the margin around skin tiles is refined). Larger tolerances find more of the skin in mixed tiles, but evaluate more pixels.
+
+		double EvaluatedFraction() const { return evaluatedFraction; } ///< Returns the number of classifications of the last image (the mean colors of the coarse level included) divided by the number of its pixels (1 without coarse-to-fine classification).
+
+		virtual bool CollectRegionStatistics() const { return collectRegionStatistics; } ///< Returns if the statistics of the skin regions are computed.
+		virtual void CollectRegionStatistics(bool val) { collectRegionStatistics = val; } ///< Can activate / deactivate the statistics of the skin regions (area, bounding box, centroid, moments, mean color). They are accumulated by the region labeling, which then also runs without region clearing.
+
+		const RegionTable& LastRegions() const { return regionTable; } ///< Returns the statistics of the skin regions of the last image before region clearing and grow / shrink (only computed if CollectRegionStatistics is activated). After processRegions it describes the last region, in the coordinates of the region with its halo.
+
+		virtual bool CollectStatistics() const { return collectStatistics; } ///< Returns if the stage times and counters are recorded.
+		virtual void CollectStatistics(bool val) { collectStatistics = val; } ///< Can activate / deactivate the recording of the stage times and counters of processImage (costs a few clock reads and a count of the skin pixels per image).
+
+		const Statistics& LastStatistics() const { return lastStatistics; } ///< Returns the stage times and counters of the last processed image (only recorded if CollectStatistics is activated).
+		const Statistics& TotalStatistics() const { return totalStatistics; } ///< Returns the stage times and counters summed over all images processed since the last ResetStatistics.
+
+		///
+		/// @brief Sets the statistics of the last image and the summed statistics to 0
+		///
+		void ResetStatistics()
+		{
+			lastStatistics.reset();
+			totalStatistics.reset();
+		}
+
+		///
+		/// @brief Returns the number of bytes of memory that are kept between the images (workspace, region labels and lookup table).
+		///
+		std::size_t WorkspaceFootprint() const
+		{
+			return workspace.footprint() + labelMask.size() * sizeof(unsigned int) + regionSizes.capacity() * sizeof(unsigned int) + regionTable.footprint() + lookupTable.capacity() * sizeof(uint64_t);
+		}
+
+		///
+		/// @brief Gives back the memory of the workspace and the region labels (the lookup table is kept). The next image allocates them again.
+		///
+		void ReleaseWorkspace()
+		{
+			workspace.release();
+			labelMask.assign();
+			std::vector<unsigned int>().swap(regionSizes);
+			regionTable.release();
+		}
+
 	protected:
 
+		///
+		/// @brief Starts recording the statistics of a call (only if CollectStatistics is activated).
+		///
+		void beginStatistics();
+
+		///
+		/// @brief Finishes recording the statistics of a call and adds them to the summed statistics.
+		/// @param pixels The number of pixels of the image
+		///
+		void endStatistics(unsigned long long pixels);
+
+		///
+		/// @brief Returns the time of a stage in the statistics of the current call, or 0 if nothing is recorded (the argument of a StageTimer).
+		///
+		inline double* stageTime(Statistics::Stage stage) { return recordingStatistics ? &lastStatistics.seconds[stage] : 0; }
+
 		// Abstract functions
 
 		///
 		/// @brief Processes the image and generates a bit mask out of it
-		/// @param img A reference to the original image data in CImg format with an arbitrary numerical standard data type
+		/// @param img A reference to the original image data in CImg format with an arbitrary numerical standard data type (RGB, a CImgArgumentException is thrown for less than 3 channels)
 		/// @return A bit mask in CImg<bool> format with the same width and height as the input image where true = skin and false = no skin
 		///
 		virtual CImg<bool>* processImage(const CImg<T> &img);
 
+		///
+		/// @brief Processes the image and writes the bit mask into a mask owned by the caller
+		/// @details The memory of the mask and of the workspace is reused, so processing images of the same size again and again does not allocate memory
+		/// (except for volumes with median filter, sizes of the median filter that CImg handles and more regions than in any image before).
+		/// @param img A reference to the original image data in CImg format with an arbitrary numerical standard data type (RGB, a CImgArgumentException is thrown for less than 3 channels)
+		/// @param mask Receives the bit mask with the same width and height as the input image where true = skin and false = no skin
+		///
+		virtual void processImage(const CImg<T> &img, CImg<bool> &mask);
+
+		///
+		/// @brief Processes image data that is not stored in a CImg (e.g. interleaved camera buffers) without copying it, and generates a bit mask out of it
+		/// @param view The image data (only read, it has to stay valid during the call)
+		/// @return A bit mask in CImg<bool> format with the same width and height as the view where true = skin and false = no skin
+		///
+		virtual CImg<bool>* processView(const ImageView<T> &view);
+
+		///
+		/// @brief Processes image data that is not stored in a CImg without copying it, and writes the bit mask into a mask owned by the caller
+		/// @param view The image data (only read, it has to stay valid during the call)
+		/// @param mask Receives the bit mask with the same width and height as the view where true = skin and false = no skin
+		///
+		virtual void processView(const ImageView<T> &view, CImg<bool> &mask);
+
+		///
+		/// @brief Processes only the regions of interest of the view and writes a bit mask of the whole view (no skin outside of the regions)
+		/// @details Median filter, classification and grow / shrink algorithms see the pixels around a region that they need (medianSize/2 plus the reach
+		/// of the grow / shrink algorithms), so the mask inside a region is the same as the mask of the whole view. Only region clearing works on each
+		/// region on its own (the largest skin region of every region of interest remains).
+		/// @param view The image data (only read, it has to stay valid during the call)
+		/// @param regions The regions of interest (clipped to the view, they may overlap)
+		/// @param mask Receives the bit mask with the same width and height as the view where true = skin and false = no skin
+		///
+		virtual void processRegions(const ImageView<T> &view, const std::vector<Rect2D> &regions, CImg<bool> &mask);
+
+		///
+		/// @brief Processes only the regions of interest of the view and writes one bit mask per region
+		/// @param view The image data (only read, it has to stay valid during the call)
+		/// @param regions The regions of interest (clipped to the view)
+		/// @param masks Receives a bit mask with the size of each clipped region (empty for regions outside of the view)
+		///
+		virtual void processRegions(const ImageView<T> &view, const std::vector<Rect2D> &regions, std::vector< CImg<bool> > &masks);
+
+		///
+		/// @brief Processes only the pixels of the view where a prior mask is true and writes a bit mask of the whole view
+		/// @details The bounding rectangles of the regions of the prior mask are processed like the regions of processRegions, afterwards the pixels
+		/// outside of the prior mask are set to no skin.
+		/// @param view The image data (only read, it has to stay valid during the call)
+		/// @param prior The prior mask (can be coarser than the view, see getRegionsOfInterest)
+		/// @param mask Receives the bit mask with the same width and height as the view where true = skin and false = no skin
+		///
+		virtual void processRegions(const ImageView<T> &view, const CImg<bool> &prior, CImg<bool> &mask);
+
+		///
+		/// @brief Filters (only if median is true), classifies and post-processes the view into the mask. Shared part of processImage and processView.
+		///
+		void segmentView(const ImageView<T> &view, bool median, CImg<bool> &mask);
+
+		///
+		/// @brief Segments a region of interest together with its border context and adds its skin pixels to the destination.
+		/// @param view The whole image data
+		/// @param region The region (has to lie inside of the view)
+		/// @param destination The first pixel of the region in the destination mask
+		/// @param destinationStride The number of pixels between two rows of the destination mask
+		/// @return The number of pixels that were classified
+		///
+		unsigned long long segmentRegion(const ImageView<T> &view, const Rect2D &region, bool *destination, std::size_t destinationStride);
+
+		///
+		/// @brief Selects the tiles of the coarse-to-fine classification that are classified completely: all tiles near the decision boundary and all tiles with a skin tile of the coarse level within pyramidMargin tiles.
+		/// @param coarse The classified mean colors of the coarse level (one per tile)
+		/// @param uncertain True for the tiles whose mean color lies within pyramidTolerance of the decision boundary
+		/// @param tiles Receives true for the tiles that are classified completely
+		///
+		void selectTiles(const CImg<bool> &coarse, const CImg<bool> &uncertain, CImg<bool> &tiles) const;
+
 		///
 		/// @brief Transforms the image data from the RGB color space to the target color space or performs other transformations. Has to be implemented by a specialized algorithm.
 		///
@@ -169,12 +339,125 @@ namespace lime{
 		// Implemented functions
 
 		///
-		/// @brief Indexes and labels all pixels in a picture by comparing it with some of its neighbors.
+		/// @brief Transforms and classifies a single row of pixels and writes the result straight into the bit mask.
+		/// @details The default implementation transforms the row with transformImage and evaluates skinThresholds for each pixel. Specialized algorithms
+		/// should override it to convert and classify in a single pass without an intermediate image.
+		/// @param r The first channel of the row (R)
+		/// @param g The second channel of the row (G)
+		/// @param b The third channel of the row (B)
+		/// @param count The number of pixels in the row
+		/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+		///
+		virtual void classifyRow(const T *r, const T *g, const T *b, unsigned int count, bool *mask);
+
+		///
+		/// @brief Classifies a single row of 8-bit pixels with one lookup per pixel in the precomputed RGB lookup table.
+		/// @param r The first channel of the row (R)
+		/// @param g The second channel of the row (G)
+		/// @param b The third channel of the row (B)
+		/// @param count The number of pixels in the row
+		/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+		/// @param step The distance between two pixels of a channel (e.g. 3 for interleaved RGB data)
+		///
+		void classifyRowLookup(const T *r, const T *g, const T *b, unsigned int count, bool *mask, std::size_t step = 1) const;
+
+		///
+		/// @brief Builds the RGB lookup table (one bit for each of the 2^24 colors) by classifying every color with classifyRow.
+		///
+		virtual void buildLookupTable();
+
+		///
+		/// @brief Prepares the classification of rows with classifyPixels (builds the lookup table if it is used and not up to date).
+		///
+		void prepareClassification();
+
+		///
+		/// @brief Classifies a single row with the lookup table if it is used, otherwise with classifyRow. prepareClassification has to be called first.
+		/// @param r The first channel of the row (R)
+		/// @param g The second channel of the row (G)
+		/// @param b The third channel of the row (B)
+		/// @param count The number of pixels in the row
+		/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+		/// @param step The distance between two pixels of a channel (e.g. 3 for interleaved RGB data)
+		///
+		inline void classifyPixels(const T *r, const T *g, const T *b, unsigned int count, bool *mask, std::size_t step = 1)
+		{
+			if (this->applyLookupTable && lookupTableSupported())
+			{
+				this->classifyRowLookup(r, g, b, count, mask, step);
+			}
+			else if (step == 1)
+			{
+				this->classifyRow(r, g, b, count, mask);
+			}
+			else
+			{
+				this->classifyStridedRow(r, g, b, count, mask, step);
+			}
+		}
+
+		///
+		/// @brief Classifies a row whose pixels are not next to each other with classifyRow, by copying it in small chunks that stay in the cache.
+		///
+		void classifyStridedRow(const T *r, const T *g, const T *b, unsigned int count, bool *mask, std::size_t step);
+
+		///
+		/// @brief Has to be called by every setter of a threshold, so the lookup table gets rebuilt before it is used the next time.
+		///
+		inline void invalidateLookupTable() { lookupTableValid = false; }
+
+		///
+		/// @brief Returns true if the lookup table can be used for images of type T (only data types with 8 bits per channel).
+		///
+		static inline bool lookupTableSupported() { return sizeof(T) == 1 && !cimg::type<T>::is_float(); }
+
+		///
+		/// @brief Applies region clearing and the grow / shrink algorithms to the classified bit mask (the part of processImage after the classification).
+		/// @details If the region statistics are collected, the regions are labeled even without region clearing.
+		/// @param img The bit mask
+		/// @param colors The image the bit mask was classified from, used for the mean colors of the region statistics (optional, has to have the size of the bit mask)
+		///
+		virtual void postprocessMask(CImg<bool> *img, const ImageView<T> *colors = 0);
+
+		///
+		/// @brief Applies the configured grow / shrink algorithms to the bit mask (in the same order as processImage always did).
+		/// @param img The bit mask
+		///
+		virtual void applyMorphology(CImg<bool> *img);
+
+		///
+		/// @brief Returns how many rows a pixel of the bit mask can be influenced by in applyMorphology. Used as the halo of the row bands.
+		/// @details Has to be overridden together with the grow / shrink algorithms if a subclass uses bigger kernels.
+		///
+		virtual unsigned int morphologyReach() const;
+
+		///
+		/// @brief Returns the thread pool for the current thread count (created on first use) or 0 if the image should be processed serially.
+		///
+		ThreadPool* threadPoolInstance();
+
+		///
+		/// @brief Labels all 8-connected skin regions of the bit mask with a two-pass union-find labeling and fills labelMask, regionSizes and biggestRegion.
+		/// @details If more than one thread is used, row bands are labeled in parallel and their labels are merged along the band borders afterwards.
+		/// If the region statistics are collected, they are accumulated in the same pass and written to regionTable.
 		/// @param img The bit mask
-		/// @param x X-coordinate of the current pixel
-		/// @param y Y-coordinate of the current pixel
+		/// @param colors The image the bit mask was classified from, used for the mean colors of the region statistics (optional)
 		///
-		virtual void pixelLabeling(CImg<bool> *img, int x, int y);
+		virtual void labelRegions(const CImg<bool> &img, const ImageView<T> *colors = 0);
+
+		///
+		/// @brief Labels the skin regions of the rows [y0,y1) of the bit mask without looking at the other rows and writes the local labels (1 to the returned count) into labelMask.
+		/// @param img The bit mask
+		/// @param y0 The first row of the band
+		/// @param y1 The row after the last row of the band
+		/// @param sizes Receives the number of pixels of each local label (index 0 is unused)
+		/// @param lastPixel Receives the linear index of the last pixel in raster order of each local label (index 0 is unused)
+		/// @param regions Receives the sums of the statistics of each local label (entry i belongs to label i+1), 0 if no statistics are collected
+		/// @param colors The image the colors of the statistics are taken from, 0 if no colors are collected
+		/// @return The number of regions in the band
+		///
+		unsigned int labelBand(const CImg<bool> &img, unsigned int y0, unsigned int y1, std::vector<unsigned int> &sizes, std::vector<unsigned int> &lastPixel,
+			RegionTable *regions, const ImageView<T> *colors);
 
 		///
 		/// @brief Used for the region clearing. Deletes all but the biggest skin region in the bit mask.
@@ -193,20 +476,30 @@ namespace lime{
 		///
 		virtual std::vector<BinarySeed>* getSeeds(bool skin, bool singleRegion, const CImg<bool> &mask, bool applyRegionChange, unsigned int regionChangeCount, unsigned int regionChangeSize);
 
+		///
+		/// @brief Uses a bit mask to determine the seed points on the borders of the skin or non-skin regions in the order of the borders (see contour::traceContours)
+		/// @param skin True if skin seed pixels should be retrieved, false if non-skin seed pixels should be retrieved
+		/// @param singleRegion Only determines the seed pixels of the first border that is being detected
+		/// @param mask The bit mask
+		/// @param applyRegionChange True if a shrink or grow (based on skin / non-skin) algorithm should be used prior to the seed pixel detection
+		/// @param regionChangeCount Number of times the shrink / grow algorithm should be used
+		/// @param regionChangeSize Size of the kernel for the shrink / grow algorithm
+		/// @param stride Only every stride-th pixel of a border is a seed
+		/// @param seeds Receives the seeds, border after border (its memory is reused)
+		/// @param contours Receives the borders with their region and the range of their seeds (its memory is reused)
+		///
+		virtual void getContourSeeds(bool skin, bool singleRegion, const CImg<bool> &mask, bool applyRegionChange, unsigned int regionChangeCount, unsigned int regionChangeSize,
+			unsigned int stride, std::vector<BinarySeed> &seeds, std::vector<contour::Contour> &contours);
+
 		///
 		/// @brief Produces a map where every pixel has a distance value based on the distance to the contour lines of the skin regions (positive values for outer pixels, negative values for inner pixels).
+		/// @details The values are the exact squared Euclidean distances to the nearest contour pixel (skin pixels with a non-skin neighbor, which get 0).
+		/// If the mask has no contour pixel, all values are 0.
 		/// @param mask The initial data stored into a binary mask
 		/// @param singleRegion If true only the biggest region will be used (more specifically the contour line of it)
 		///
 		virtual CImg<int>* getDistanceMapOfMask(CImg<bool> &mask, bool singleRegion = false);
 
-		///
-		/// @brief Auxiliary function for "getDistanceMapOfMask" to determine the distances between the queryPoints and the contour points
-		/// @param st The search tree that should have information about the contour points stored into it
-		/// @param queryPoints The points for which the distances should be determined
-		///
-		virtual cv::Mat_<double> findDistances(SearchTree& st, const cv::Mat_<double>& queryPoints);
-
 		///
 		/// @brief Applies a grow and shrink algorithm on the bit mask (grow:shrink = 1:1).
 		/// @param img The bit mask
@@ -270,12 +563,7 @@ namespace lime{
 		bool applyShrink;
 
 		///
-		/// @brief Used for the region clearing. An outer vector for each label. An inner vector for the coordinates of each pixel of one label.
-		///
-		std::vector< std::vector <Point2D> > labeledPixels;
-
-		///
-		/// @brief Used for the region clearing. A temporary mask that contains the label of each pixel. 
+		/// @brief Used for the region clearing. A temporary mask that contains the label of each pixel (1 to regionCount, 0 = no skin).
 		///
 		CImg<unsigned int> labelMask;
 		///
@@ -284,10 +572,15 @@ namespace lime{
 		unsigned int regionCount;
 
 		///
-		/// @brief Used for the region clearing. A vector for each label which contains the number of pixels belonging to this label.
+		/// @brief Used for the region clearing. The number of pixels belonging to each label (index 0 is unused).
 		///
 		std::vector<unsigned int> regionSizes;
 
+		///
+		/// @brief The statistics of the regions of the last labeled bit mask (entry i belongs to label i).
+		///
+		RegionTable regionTable;
+
 		///
 		/// @brief The number of times the shrink algorithm should be applied (only has an effect if applyShrink = true).
 		///
@@ -323,286 +616,1352 @@ namespace lime{
 		///
 		bool applyRegionClearing;
 
-	};
+		///
+		/// @brief Determines if the precomputed RGB lookup table should be used for the classification of 8-bit images.
+		///
+		bool applyLookupTable;
 
-	template<typename T>
-	CImg<bool>* lime::Algorithm<T>::processImage( const CImg<T> &img )
-	{
+		///
+		/// @brief Determines if the single precision SIMD kernels should be used for the classification of 8-bit images.
+		///
+		bool applyVectorization;
 
-		int _width = img.width();
-		int _height = img.height();
+		///
+		/// @brief True if the lookup table matches the current thresholds.
+		///
+		bool lookupTableValid;
 
-		CImg<T> medianImg;
+		///
+		/// @brief The RGB lookup table. Bit (r << 16 | g << 8 | b) is set if the color is a skin color.
+		///
+		std::vector<uint64_t> lookupTable;
 
-		// Applying a median filter if applyMedian = true
-		if (this->applyMedian)
-		{
-			medianImg = img.get_blur_median(this->medianSize);
-		}
-		else
-		{
-			medianImg.assign(img);
-		}		
+		///
+		/// @brief The number of threads that process an image (1 = serial, 0 = all hardware threads).
+		///
+		unsigned int threadCount;
 
-		// The bit mask should have the same width and height but only one channel and bool variables for each pixel
-		CImg<bool> *resImg = new CImg<bool>(_width,_height,1,1);
+		///
+		/// @brief The pool that runs the row bands. Kept alive between the images and shared between copies of the algorithm.
+		///
+		std::shared_ptr<ThreadPool> threadPool;
 
-		// Changes the color space of the image data from RGB to the target color space
-		CImg<double> *transformedImg = this->transformImage(medianImg);
+		///
+		/// @brief The size of the tiles of the coarse-to-fine classification (1 = every pixel is classified).
+		///
+		unsigned int pyramidFactor;
 
-		// The 3 channels of the image data
-		double c1,c2,c3;
+		///
+		/// @brief The number of tiles around a skin tile of the coarse level that are classified completely.
+		///
+		unsigned int pyramidMargin;
 
-		// Depending whether or not region clearing is active (which means that only the biggest region will remain at the end) some labeling is added to the loop
-		if (!this->applyRegionClearing)
-		{
-			for (int y = 0; y < _height; y++)
-			{
-				for (int x = 0; x < _width; x++)
-				{
-					c1 = (*transformedImg)(x,y,0,0);
-					c2 = (*transformedImg)(x,y,0,1);
-					c3 = (*transformedImg)(x,y,0,2);
+		///
+		/// @brief The distance to the decision boundary (per color channel) within which the tiles of the coarse level are classified completely.
+		///
+		Threshold pyramidTolerance;
 
-					// Uses the data from the skinThresholds method passing all 3 channels to it to determined whether the pixel is skin or not
-					(*resImg)(x,y,0,0) = this->skinThresholds(c1,c2,c3);
-				}
-			}
-		}
-		else
-		{
-			// Reset of the corresponding member variables
-			this->regionCount = 0;
-			this->biggestRegion = 0;
-			this->regionSizes = std::vector<unsigned int>();
-			this->regionSizes.reserve((_width * _height)/4);
-			this->labeledPixels = std::vector< std::vector <Point2D> >();
-			this->labeledPixels.reserve((_width*_height)/4);
-			this->labelMask = CImg<unsigned int>(_width,_height,1,1,0);
+		///
+		/// @brief The fraction of the pixels of the last image that were classified.
+		///
+		double evaluatedFraction;
 
-			for (int y = 0; y < _height; y++)
-			{
-				for (int x = 0; x < _width; x++)
-				{
-					c1 = (*transformedImg)(x,y,0,0);
-					c2 = (*transformedImg)(x,y,0,1);
-					c3 = (*transformedImg)(x,y,0,2);
+		///
+		/// @brief The temporary buffers of the segmentation steps, kept between the images.
+		///
+		Workspace<T> workspace;
 
-					// Uses the data from the skinThresholds method passing all 3 channels to it to determined whether the pixel is skin or not. Also if the pixel is a skin pixel
-					// the labeling method will be applied to it.
-					if (this->skinThresholds(c1,c2,c3))
-					{
-						(*resImg)(x,y,0,0) = true;
-						pixelLabeling(resImg,x,y);
-					}
-					else
-					{
-						(*resImg)(x,y,0,0) = false;
-					}
-				}
-			}
+		///
+		/// @brief Determines if the statistics of the skin regions are accumulated by the labeling.
+		///
+		bool collectRegionStatistics;
 
-			this->deleteMinorRegions(resImg);
-		}
+		///
+		/// @brief Determines if the stage times and counters of processImage are recorded.
+		///
+		bool collectStatistics;
 
+		///
+		/// @brief True while the statistics of a call are recorded.
+		///
+		bool recordingStatistics;
 
-		// Applying Grow and / or Shrink Algorithm
+		///
+		/// @brief The workspace footprint and the time at the start of the recorded call.
+		///
+		std::size_t statisticsFootprint;
+		std::chrono::steady_clock::time_point statisticsStart;
 
-		if (this->applyGrowBeforeShrink)
-		{
-			if (this->applyGrow)
-			{
-				this->growAlgorithm(resImg, this->growCount, this->growSize);
-			}
+		///
+		/// @brief The statistics of the last processed image.
+		///
+		Statistics lastStatistics;
 
-			if (this->applyShrink)
-			{
-				this->shrinkAlgorithm(resImg, this->growCount, this->growSize);
-			}
-		}
-		else
-		{
-			if (this->applyShrink)
-			{
-				this->shrinkAlgorithm(resImg, this->growCount, this->growSize);
-			}
+		///
+		/// @brief The statistics summed over all processed images.
+		///
+		Statistics totalStatistics;
 
-			if (this->applyGrow)
-			{
-				this->growAlgorithm(resImg, this->growCount, this->growSize);
-			}
-		}
+	};
 
-		//Applying a fixed GrowShrink-Algorithm
-		if (this->applyFixedGrowShrink)
-		{
-			this->growShrinkAlgorithm(resImg, this->fixedGrowShrinkCount, this->fixedGrowShrinkSize);
-		}
+	template<typename T>
+	CImg<bool>* lime::Algorithm<T>::processImage( const CImg<T> &img )
+	{
+		CImg<bool> *resImg = new CImg<bool>();
 
-		// some cleanup
-		delete transformedImg;
+		this->processImage(img, *resImg);
 
 		return resImg;
 	}
 
 	template<typename T>
-	void lime::Algorithm<T>::growShrinkAlgorithm( CImg<bool> *img, const unsigned int count, const unsigned int size )
+	void lime::Algorithm<T>::processImage( const CImg<T> &img, CImg<bool> &mask )
 	{
-		for (unsigned int i = 0; i < count; i++ )
+		checkChannels(img.spectrum(), "lime::Algorithm::processImage()");
+
+		this->beginStatistics();
+
+		// The median filter of a volume works in 3D, only the first slice is classified
+		if (img.depth() > 1 && this->applyMedian)
 		{
-			if (this->applyGrowBeforeShrink)
+			CImg<T> medianImg;
+
 			{
-				this->growAlgorithm(img, 1, size);
-				this->shrinkAlgorithm(img, 1, size);
-			}
-			else
-			{				
-				this->shrinkAlgorithm(img, 1, size);
-				this->growAlgorithm(img, 1, size);
+				StageTimer timer(this->stageTime(Statistics::StageMedian));
+				medianImg = img.get_blur_median(this->medianSize);
 			}
+
+			this->segmentView(ImageView<T>(medianImg), false, mask);
+		}
+		else
+		{
+			this->segmentView(ImageView<T>(img), this->applyMedian, mask);
 		}
+
+		this->endStatistics((unsigned long long)img.width() * img.height());
 	}
 
 	template<typename T>
-	void lime::Algorithm<T>::growAlgorithm( CImg<bool> *img, const unsigned int count, const unsigned int size)
+	CImg<bool>* lime::Algorithm<T>::processView( const ImageView<T> &view )
 	{
-		for(unsigned int i = 0; i < count; i++)
-		{
-			img->dilate(size);
-		}
+		CImg<bool> *resImg = new CImg<bool>();
+
+		this->processView(view, *resImg);
+
+		return resImg;
 	}
 
 	template<typename T>
-	void lime::Algorithm<T>::shrinkAlgorithm( CImg<bool> *img, const unsigned int count, const unsigned int size)
+	void lime::Algorithm<T>::processView( const ImageView<T> &view, CImg<bool> &mask )
 	{
-		for(unsigned int i = 0; i < count; i++)
-		{
-			img->erode(size);
-		}
+		checkChannels(view.channels(), "lime::Algorithm::processView()");
+
+		this->beginStatistics();
+		this->segmentView(view, this->applyMedian, mask);
+		this->endStatistics((unsigned long long)view.width * view.height);
 	}
 
 	template<typename T>
-	inline void lime::Algorithm<T>::pixelLabeling(CImg<bool> *img, int x, int y )
+	void lime::Algorithm<T>::processRegions( const ImageView<T> &view, const std::vector<Rect2D> &regions, CImg<bool> &mask )
 	{
-		// Some setups if the current pixel is not yet labeled
-		if (this->labelMask(x,y,0,0) == 0)
-		{
-			// Gets a new label for that pixel
-			this->labelMask(x,y,0,0) = this->regionCount++;
+		checkChannels(view.channels(), "lime::Algorithm::processRegions()");
 
-			// Stores the position data of the pixel to a new outer vector of labeledPixels
-			std::vector<Point2D> tempVect;
-			Point2D tempPoint(x,y);
-			tempVect.push_back(tempPoint);
-			this->labeledPixels.push_back(tempVect);
-			// Stores the region size as a new entry to regionSizes
-			this->regionSizes.push_back(1);
-		}
+		this->beginStatistics();
+
+		mask.assign(view.width,view.height,1,1);
+		mask.fill(false);
+
+		unsigned long long pixels = 0, evaluatedPixels = 0;
 
-		// Compare labeling with the adjacent pixels (left-up, left, up, right-up)
-		for (int k = 0; k < 4; k++)
+		for (std::size_t i = 0; i < regions.size(); i++)
 		{
-			// Coordinates of the adjacent pixel that is being compared to the current pixel
-			int adjX, adjY;
+			const Rect2D region = regions[i].clipped(view.width, view.height);
 
-			switch (k)
+			if (!region.empty())
 			{
-			case 0: adjX = x-1;
-				adjY = y-1;
-				break;
-			case 1: adjX = x-1;
-				adjY = y;
-				break;
-			case 2: adjX = x;
-				adjY = y-1;
-				break;
-			case 3: adjX = x+1;
-				adjY = y-1;
-				break;
-			default: break;
+				evaluatedPixels += this->segmentRegion(view, region, mask.data(region.x,region.y,0,0), mask.width());
+				pixels += (unsigned long long)region.width * region.height;
 			}
+		}
+
+		this->evaluatedFraction = mask.size() ? (double)evaluatedPixels / mask.size() : 0.0;
+		this->endStatistics(pixels);
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::processRegions( const ImageView<T> &view, const std::vector<Rect2D> &regions, std::vector< CImg<bool> > &masks )
+	{
+		checkChannels(view.channels(), "lime::Algorithm::processRegions()");
+
+		this->beginStatistics();
+
+		masks.resize(regions.size());
+
+		unsigned long long pixels = 0, evaluatedPixels = 0;
+
+		for (std::size_t i = 0; i < regions.size(); i++)
+		{
+			const Rect2D region = regions[i].clipped(view.width, view.height);
+
+			if (region.empty())
+			{
+				masks[i].assign();
+				continue;
+			}
+
+			masks[i].assign(region.width,region.height,1,1);
+			masks[i].fill(false);
+
+			evaluatedPixels += this->segmentRegion(view, region, masks[i].data(), region.width);
+			pixels += (unsigned long long)region.width * region.height;
+		}
+
+		const unsigned long long viewPixels = (unsigned long long)view.width * view.height;
+		this->evaluatedFraction = viewPixels ? (double)evaluatedPixels / viewPixels : 0.0;
+		this->endStatistics(pixels);
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::processRegions( const ImageView<T> &view, const CImg<bool> &prior, CImg<bool> &mask )
+	{
+		getRegionsOfInterest(prior, view.width, view.height, this->workspace.regions, this->workspace.visited, this->workspace.regionStack);
+
+		this->processRegions(view, this->workspace.regions, mask);
+
+		// Pixel (x,y) belongs to the value (x*priorWidth/width, y*priorHeight/height) of the prior mask
+		const unsigned long long priorWidth = prior.width(), priorHeight = prior.height();
+
+		for (std::size_t i = 0; i < this->workspace.regions.size(); i++)
+		{
+			const Rect2D &region = this->workspace.regions[i];
+
+			for (int y = region.y; y < region.y + region.height; y++)
+			{
+				const bool *priorRow = prior.data(0,(int)(y * priorHeight / view.height),0,0);
+				bool *row = mask.data(0,y,0,0);
+
+				for (int x = region.x; x < region.x + region.width; x++)
+				{
+					row[x] = row[x] && priorRow[x * priorWidth / view.width];
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	unsigned long long lime::Algorithm<T>::segmentRegion( const ImageView<T> &view, const Rect2D &region, bool *destination, std::size_t destinationStride )
+	{
+		// The median of a pixel depends on the pixels up to medianSize/2 away, the grow / shrink algorithms on the classified pixels up to their reach
+		const int context = (int)((this->applyMedian ? this->medianSize / 2 : 0) + this->morphologyReach());
+		const Rect2D outer = region.expanded(context).clipped(view.width, view.height);
+
+		CImg<bool> &regionMask = this->workspace.regionMask;
+		this->segmentView(view.crop(outer), this->applyMedian, regionMask);
+
+		const unsigned long long evaluatedPixels = (unsigned long long)(this->evaluatedFraction * outer.width * outer.height + 0.5);
+
+		// Only the region itself is copied, its border context can differ from the mask of the whole view
+		for (int y = 0; y < region.height; y++)
+		{
+			const bool *src = regionMask.data(region.x - outer.x,region.y - outer.y + y,0,0);
+			bool *dst = destination + y * destinationStride;
+
+			for (int x = 0; x < region.width; x++)
+			{
+				dst[x] = dst[x] || src[x];
+			}
+		}
+
+		return evaluatedPixels;
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::beginStatistics()
+	{
+		if (!this->collectStatistics)
+		{
+			return;
+		}
+
+		this->lastStatistics.reset();
+		this->recordingStatistics = true;
+		this->statisticsFootprint = this->WorkspaceFootprint();
+		this->statisticsStart = std::chrono::steady_clock::now();
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::endStatistics( unsigned long long pixels )
+	{
+		if (!this->recordingStatistics)
+		{
+			return;
+		}
+
+		const std::size_t footprint = this->WorkspaceFootprint();
+
+		this->lastStatistics.totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->statisticsStart).count();
+		this->lastStatistics.calls = 1;
+		this->lastStatistics.pixels = pixels;
+		this->lastStatistics.bytesAllocated = (footprint > this->statisticsFootprint) ? footprint - this->statisticsFootprint : 0;
+
+		this->totalStatistics += this->lastStatistics;
+		this->recordingStatistics = false;
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::segmentView( const ImageView<T> &view, bool median, CImg<bool> &mask )
+	{
+
+		const int _width = view.width;
+		const int _height = view.height;
+
+		// The table has to be complete before the bands start to read from it
+		this->prepareClassification();
+
+		// Coarse-to-fine classification: the mean colors of the factor x factor tiles are classified first, then only the tiles near skin or near the
+		// decision boundary are filtered and classified completely
+		const int factor = (int)std::max(1u, this->pyramidFactor);
+		const bool pyramid = factor > 1;
+		const int tilesX = (_width + factor - 1) / factor;
+		const int tilesY = (_height + factor - 1) / factor;
+
+		// The image is split into horizontal bands, one per thread (a single band covering the whole image if it is processed serially). With
+		// coarse-to-fine classification the bands consist of whole tile rows.
+		ThreadPool *pool = this->threadPoolInstance();
+		const unsigned int bandCount = pool ? std::max(1u, std::min<unsigned int>(pool->size(), pyramid ? tilesY : _height)) : 1;
+
+		this->workspace.reserveBands(bandCount);
+
+		// The bit mask should have the same width and height but only one channel and bool variables for each pixel
+		mask.assign(_width,_height,1,1);
+
+		if (pyramid)
+		{
+			this->workspace.coarseColors.assign(tilesX,tilesY,1,3);
+			this->workspace.coarse.assign(tilesX,tilesY,1,1);
+			this->workspace.uncertain.assign(tilesX,tilesY,1,1);
+		}
+
+		// The median of a row depends on medianSize/2 rows above and below it, so a band (or a run of tiles) is filtered together with this halo
+		const int halo = this->medianSize / 2;
+
+		auto tileRowStart = [&](unsigned int band) { return (int)(band * tilesY / bandCount); };
+		auto bandStart = [&](unsigned int band) { return pyramid ? std::min(_height, tileRowStart(band) * factor) : (int)(band * _height / bandCount); };
+		auto haloStart = [&](unsigned int band) { return (bandCount == 1) ? 0 : std::max(0, bandStart(band) - halo); };
+
+		// Classifies count pixels of row y, starting at column x, out of the view or out of a median filtered part of it whose first pixel lies at (left,top)
+		auto classifyRun = [&](typename Workspace<T>::Band &buffers, const CImg<T> *filtered, int left, int top, int x, int y, unsigned int count, bool *result)
+		{
+			if (filtered)
+			{
+				this->classifyPixels(filtered->data(x-left,y-top,0,0), filtered->data(x-left,y-top,0,1), filtered->data(x-left,y-top,0,2), count, result);
+			}
+			else
+			{
+				// The rows are classified straight from the view
+				const std::size_t step = view.pixelStep();
+				this->classifyPixels(view.row(0,y) + x * step, view.row(1,y) + x * step, view.row(2,y) + x * step, count, result, step);
+			}
+
+			buffers.evaluatedPixels += count;
+		};
+
+		// Computes the mean colors of the tiles of tile row ty and classifies them. With a tolerance the mean colors are also classified with every
+		// channel moved by the tolerance in both directions, tiles whose result changes lie near the decision boundary.
+		auto classifyTileRow = [&](typename Workspace<T>::Band &buffers, int ty)
+		{
+			CImg<T> &colors = this->workspace.coarseColors;
+			bool *coarseRow = this->workspace.coarse.data(0,ty,0,0);
+			bool *uncertainRow = this->workspace.uncertain.data(0,ty,0,0);
+			std::vector<double> &sums = buffers.tileSums;
+
+			const int top = ty * factor;
+			const int bottom = std::min(_height, top + factor);
+			const std::size_t step = view.pixelStep();
+
+			for (int c = 0; c < 3; c++)
+			{
+				sums.assign(tilesX, 0.0);
+
+				for (int y = top; y < bottom; y++)
+				{
+					const T *src = view.row(c,y);
+
+					for (int tx = 0; tx < tilesX; tx++)
+					{
+						const int x1 = std::min(_width, (tx + 1) * factor);
+						double sum = 0.0;
+
+						for (int x = tx * factor; x < x1; x++)
+						{
+							sum += (double)src[x * step];
+						}
+
+						sums[tx] += sum;
+					}
+				}
+
+				for (int tx = 0; tx < tilesX; tx++)
+				{
+					const int pixels = (std::min(_width, (tx + 1) * factor) - tx * factor) * (bottom - top);
+					const double mean = sums[tx] / pixels;
+
+					colors(tx,ty,0,c) = cimg::type<T>::cut(cimg::type<T>::is_float() ? mean : mean + 0.5);
+				}
+			}
+
+			classifyRun(buffers, &colors, 0, 0, 0, ty, tilesX, coarseRow);
+			std::fill(uncertainRow, uncertainRow + tilesX, false);
+
+			if (this->pyramidTolerance <= 0.0)
+			{
+				return;
+			}
+
+			CImg<T> &shifted = buffers.shifted;
+			shifted.assign(tilesX,1,1,3);
+			buffers.shiftedMask.assign(tilesX,1,1,1);
+
+			for (int c = 0; c < 3; c++)
+			{
+				for (int direction = -1; direction <= 1; direction += 2)
+				{
+					for (int k = 0; k < 3; k++)
+					{
+						std::copy(colors.data(0,ty,0,k), colors.data(0,ty,0,k) + tilesX, shifted.data(0,0,0,k));
+					}
+
+					for (int tx = 0; tx < tilesX; tx++)
+					{
+						shifted(tx,0,0,c) = cimg::type<T>::cut((double)colors(tx,ty,0,c) + direction * this->pyramidTolerance);
+					}
+
+					classifyRun(buffers, &shifted, 0, ty, 0, ty, tilesX, buffers.shiftedMask.data());
+
+					for (int tx = 0; tx < tilesX; tx++)
+					{
+						uncertainRow[tx] = uncertainRow[tx] || (buffers.shiftedMask[tx] != coarseRow[tx]);
+					}
+				}
+			}
+		};
+
+		// Applies the median filter (if median = true), changes the color space of the image data and classifies it row by row, so no transformed copy of the whole image is needed.
+		// With coarse-to-fine classification only the coarse level is classified here.
+		auto classifyBand = [&](unsigned int band)
+		{
+			const int y0 = bandStart(band);
+			const int y1 = bandStart(band + 1);
+			const int offset = haloStart(band);
+
+			typename Workspace<T>::Band &buffers = this->workspace.band(band);
+			buffers.medianSeconds = 0.0;
+			buffers.classificationSeconds = 0.0;
+			buffers.evaluatedPixels = 0;
+
+			if (pyramid)
+			{
+				// The coarse level is taken from the unfiltered view, the mean of a tile already suppresses the noise the median removes
+				StageTimer timer(this->recordingStatistics ? &buffers.classificationSeconds : 0);
+
+				for (int ty = tileRowStart(band); ty < tileRowStart(band + 1); ty++)
+				{
+					classifyTileRow(buffers, ty);
+				}
+
+				return;
+			}
+
+			if (median)
+			{
+				const int end = (bandCount == 1) ? _height : std::min(_height, y1 + halo);
+
+				StageTimer timer(this->recordingStatistics ? &buffers.medianSeconds : 0);
+
+				view.getRows(offset, end, buffers.input);
+				median::blurMedian(buffers.input, this->medianSize, buffers.filtered, 0, &buffers.histograms);
+			}
+
+			StageTimer timer(this->recordingStatistics ? &buffers.classificationSeconds : 0);
+
+			for (int y = y0; y < y1; y++)
+			{
+				classifyRun(buffers, median ? &buffers.filtered : 0, 0, offset, 0, y, _width, mask.data(0,y,0,0));
+			}
+		};
+
+		// Filters and classifies the selected tiles completely and sets the other tiles to no skin (runs after the coarse level is classified)
+		auto refineBand = [&](unsigned int band)
+		{
+			typename Workspace<T>::Band &buffers = this->workspace.band(band);
+			const CImg<bool> &tiles = this->workspace.tiles;
+
+			if (median)
+			{
+				// The largest run is a whole tile row with the halo, smaller runs use the front of the buffers
+				buffers.input.assign(_width,std::min(_height, factor + 2 * halo),1,3);
+				buffers.filtered.assign(_width,std::min(_height, factor + 2 * halo),1,3);
+			}
+
+			for (int ty = tileRowStart(band); ty < tileRowStart(band + 1); ty++)
+			{
+				const bool *tileRow = tiles.data(0,ty,0,0);
+				const int top = ty * factor;
+				const int bottom = std::min(_height, top + factor);
+
+				// Neighboring tiles with the same decision are handled as one run
+				for (int tx = 0; tx < tilesX; )
+				{
+					const bool refine = tileRow[tx];
+					int next = tx + 1;
+
+					while (next < tilesX && tileRow[next] == refine)
+					{
+						next++;
+					}
+
+					const int x0 = tx * factor;
+					const int x1 = std::min(_width, next * factor);
+
+					if (!refine)
+					{
+						for (int y = top; y < bottom; y++)
+						{
+							std::fill(mask.data(x0,y,0,0), mask.data(x1,y,0,0), false);
+						}
+					}
+					else if (median)
+					{
+						// Only the run and its halo are filtered, in views of the band buffers (which do not allocate)
+						const Rect2D area = Rect2D(x0, top, x1 - x0, bottom - top).expanded(halo).clipped(_width, _height);
+						CImg<T> input(buffers.input.data(), area.width, area.height, 1, 3, true);
+						CImg<T> filtered(buffers.filtered.data(), area.width, area.height, 1, 3, true);
+
+						{
+							StageTimer timer(this->recordingStatistics ? &buffers.medianSeconds : 0);
+
+							view.crop(area).getRows(0, area.height, input);
+							median::blurMedian(input, this->medianSize, filtered, 0, &buffers.histograms);
+						}
+
+						StageTimer timer(this->recordingStatistics ? &buffers.classificationSeconds : 0);
+
+						for (int y = top; y < bottom; y++)
+						{
+							classifyRun(buffers, &filtered, area.x, area.y, x0, y, x1 - x0, mask.data(x0,y,0,0));
+						}
+					}
+					else
+					{
+						StageTimer timer(this->recordingStatistics ? &buffers.classificationSeconds : 0);
+
+						for (int y = top; y < bottom; y++)
+						{
+							classifyRun(buffers, 0, 0, 0, x0, y, x1 - x0, mask.data(x0,y,0,0));
+						}
+					}
+
+					tx = next;
+				}
+			}
+		};
+
+		if (pool)
+		{
+			// The reference wrapper keeps std::function from copying the lambda to the heap
+			pool->parallelFor(bandCount, std::ref(classifyBand));
+		}
+		else
+		{
+			classifyBand(0);
+		}
+
+		if (pyramid)
+		{
+			{
+				StageTimer timer(this->stageTime(Statistics::StageClassification));
+				this->selectTiles(this->workspace.coarse, this->workspace.uncertain, this->workspace.tiles);
+			}
+
+			if (pool)
+			{
+				pool->parallelFor(bandCount, std::ref(refineBand));
+			}
+			else
+			{
+				refineBand(0);
+			}
+		}
+
+		unsigned long long evaluatedPixels = 0;
+
+		for (unsigned int band = 0; band < bandCount; band++)
+		{
+			evaluatedPixels += this->workspace.band(band).evaluatedPixels;
+		}
+
+		const unsigned long long pixels = (unsigned long long)_width * _height;
+		this->evaluatedFraction = (pixels > 0) ? (double)evaluatedPixels / pixels : 0.0;
+
+		if (this->recordingStatistics)
+		{
+			// The bands run at the same time, so the slowest band determines the time of a stage
+			double medianSeconds = 0.0, classificationSeconds = 0.0;
+
+			for (unsigned int band = 0; band < bandCount; band++)
+			{
+				medianSeconds = std::max(medianSeconds, this->workspace.band(band).medianSeconds);
+				classificationSeconds = std::max(classificationSeconds, this->workspace.band(band).classificationSeconds);
+			}
+
+			this->lastStatistics.seconds[Statistics::StageMedian] += medianSeconds;
+			this->lastStatistics.seconds[Statistics::StageClassification] += classificationSeconds;
+			this->lastStatistics.evaluatedPixels += evaluatedPixels;
+
+			const bool *skin = mask.data();
+			unsigned long long skinPixels = 0;
+
+			for (std::size_t p = 0; p < mask.size(); p++)
+			{
+				skinPixels += skin[p] ? 1 : 0;
+			}
+
+			this->lastStatistics.skinPixels += skinPixels;
+		}
+
+		this->postprocessMask(&mask, &view);
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::selectTiles( const CImg<bool> &coarse, const CImg<bool> &uncertain, CImg<bool> &tiles ) const
+	{
+		const int tilesX = coarse.width();
+		const int tilesY = coarse.height();
+		const int margin = (int)this->pyramidMargin;
+
+		tiles.assign(tilesX,tilesY,1,1);
+
+		for (int ty = 0; ty < tilesY; ty++)
+		{
+			const int top = std::max(0, ty - margin);
+			const int bottom = std::min(tilesY - 1, ty + margin);
+
+			for (int tx = 0; tx < tilesX; tx++)
+			{
+				const int left = std::max(0, tx - margin);
+				const int right = std::min(tilesX - 1, tx + margin);
+
+				bool skin = uncertain(tx,ty);
+
+				for (int y = top; y <= bottom && !skin; y++)
+				{
+					const bool *row = coarse.data(0,y,0,0);
+
+					for (int x = left; x <= right && !skin; x++)
+					{
+						skin = row[x];
+					}
+				}
+
+				tiles(tx,ty) = skin;
+			}
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::prepareClassification()
+	{
+		if (this->applyLookupTable && lookupTableSupported() && !this->lookupTableValid)
+		{
+			this->buildLookupTable();
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::postprocessMask( CImg<bool> *img, const ImageView<T> *colors )
+	{
+		const int _width = img->width();
+		const int _height = img->height();
+
+		ThreadPool *pool = (img->depth() == 1) ? this->threadPoolInstance() : 0;
+		const unsigned int bandCount = pool ? std::min<unsigned int>(pool->size(), _height) : 1;
+
+		// If region clearing is active (which means that only the biggest region will remain at the end) or the region statistics are collected the skin pixels are labeled
+		if (this->applyRegionClearing || this->collectRegionStatistics)
+		{
+			StageTimer timer(this->stageTime(Statistics::StageLabeling));
+
+			const bool useColors = colors && img->depth() == 1 && colors->width == (unsigned int)_width && colors->height == (unsigned int)_height;
+			this->labelRegions(*img, useColors ? colors : 0);
+
+			if (this->applyRegionClearing)
+			{
+				this->deleteMinorRegions(img);
+			}
+
+			if (this->recordingStatistics)
+			{
+				this->lastStatistics.regions += this->regionCount;
+			}
+		}
+
+		// Applying Grow and / or Shrink Algorithm
+		StageTimer timer(this->stageTime(Statistics::StageMorphology));
+		const unsigned int halo = this->morphologyReach();
+
+		if (pool && halo > 0 && 2 * halo < _height / bandCount)
+		{
+			// Every band is processed together with the rows that can influence it, the results are written back without the halo
+			CImg<bool> &srcMask = this->workspace.maskCopy;
+			srcMask = *img;
+
+			this->workspace.reserveBands(bandCount);
+
+			auto processBand = [&](unsigned int band)
+			{
+				const int y0 = (int)(band * _height / bandCount);
+				const int y1 = (int)((band + 1) * _height / bandCount);
+				const int offset = std::max(0, y0 - (int)halo);
+				const int end = std::min(_height, y1 + (int)halo);
+
+				CImg<bool> &bandMask = this->workspace.band(band).mask;
+				bandMask.assign(srcMask.data(0,offset,0,0), _width, end - offset, 1, 1);
+
+				this->applyMorphology(&bandMask);
+
+				std::memcpy(img->data(0,y0,0,0), bandMask.data(0,y0-offset,0,0), (size_t)(y1 - y0) * _width * sizeof(bool));
+			};
+
+			pool->parallelFor(bandCount, std::ref(processBand));
+		}
+		else
+		{
+			this->applyMorphology(img);
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::applyMorphology( CImg<bool> *img )
+	{
+		if (this->applyGrowBeforeShrink)
+		{
+			if (this->applyGrow)
+			{
+				this->growAlgorithm(img, this->growCount, this->growSize);
+			}
+
+			if (this->applyShrink)
+			{
+				this->shrinkAlgorithm(img, this->growCount, this->growSize);
+			}
+		}
+		else
+		{
+			if (this->applyShrink)
+			{
+				this->shrinkAlgorithm(img, this->growCount, this->growSize);
+			}
+
+			if (this->applyGrow)
+			{
+				this->growAlgorithm(img, this->growCount, this->growSize);
+			}
+		}
+
+		//Applying a fixed GrowShrink-Algorithm
+		if (this->applyFixedGrowShrink)
+		{
+			this->growShrinkAlgorithm(img, this->fixedGrowShrinkCount, this->fixedGrowShrinkSize);
+		}
+	}
+
+	template<typename T>
+	unsigned int lime::Algorithm<T>::morphologyReach() const
+	{
+		// A dilation or erosion with kernel size s reaches s/2 rows in each direction (the kernel is anchored like in CImg)
+		unsigned int reach = 0;
+
+		if (this->applyGrow)
+		{
+			reach += this->growCount * (this->growSize / 2);
+		}
+
+		if (this->applyShrink)
+		{
+			reach += this->growCount * (this->growSize / 2);
+		}
+
+		if (this->applyFixedGrowShrink)
+		{
+			reach += 2 * this->fixedGrowShrinkCount * (this->fixedGrowShrinkSize / 2);
+		}
+
+		return reach;
+	}
+
+	template<typename T>
+	ThreadPool* lime::Algorithm<T>::threadPoolInstance()
+	{
+		const unsigned int count = this->threadCount ? this->threadCount : std::thread::hardware_concurrency();
+
+		if (count <= 1)
+		{
+			return 0;
+		}
+
+		if (!this->threadPool)
+		{
+			this->threadPool = std::shared_ptr<ThreadPool>(new ThreadPool(count));
+		}
+
+		return this->threadPool.get();
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::classifyRow( const T *r, const T *g, const T *b, unsigned int count, bool *mask )
+	{
+		CImg<T> row(count,1,1,3);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			row(i,0,0,0) = r[i];
+			row(i,0,0,1) = g[i];
+			row(i,0,0,2) = b[i];
+		}
+
+		// Changes the color space of the row from RGB to the target color space
+		CImg<double> *transformedRow = this->transformImage(row);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			// Uses the data from the skinThresholds method passing all 3 channels to it to determined whether the pixel is skin or not
+			mask[i] = this->skinThresholds((*transformedRow)(i,0,0,0), (*transformedRow)(i,0,0,1), (*transformedRow)(i,0,0,2));
+		}
+
+		delete transformedRow;
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::classifyStridedRow( const T *r, const T *g, const T *b, unsigned int count, bool *mask, std::size_t step )
+	{
+		// The chunk is small enough for the stack, and classifyRow (and its vectorized kernels) still sees contiguous rows
+		const unsigned int chunk = 256;
+		T cr[chunk], cg[chunk], cb[chunk];
+
+		for (unsigned int i0 = 0; i0 < count; i0 += chunk)
+		{
+			const unsigned int n = std::min(chunk, count - i0);
+
+			for (unsigned int i = 0; i < n; i++)
+			{
+				const std::size_t j = (std::size_t)(i0 + i) * step;
+
+				cr[i] = r[j];
+				cg[i] = g[j];
+				cb[i] = b[j];
+			}
+
+			this->classifyRow(cr, cg, cb, n, mask + i0);
+		}
+	}
+
+	template<typename T>
+	inline void lime::Algorithm<T>::classifyRowLookup( const T *r, const T *g, const T *b, unsigned int count, bool *mask, std::size_t step ) const
+	{
+		const uint64_t *table = &this->lookupTable[0];
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const std::size_t j = i * step;
+			const uint32_t index = ((uint32_t)(unsigned char)r[j] << 16) | ((uint32_t)(unsigned char)g[j] << 8) | (uint32_t)(unsigned char)b[j];
+
+			mask[i] = ((table[index >> 6] >> (index & 63)) & 1) != 0;
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::buildLookupTable()
+	{
+		this->lookupTable.assign((1 << 24)/64, 0);
+
+		// Every red value fills its own part of the table, so they can be classified in parallel
+		std::function<void(unsigned int)> buildRed = [this](unsigned int red)
+		{
+			// One row holds all 256 blue values for a fixed red and green value
+			T r[256], g[256], b[256];
+			bool row[256];
+
+			for (unsigned int i = 0; i < 256; i++)
+			{
+				b[i] = (T)(unsigned char)i;
+			}
+
+			for (unsigned int green = 0; green < 256; green++)
+			{
+				for (unsigned int i = 0; i < 256; i++)
+				{
+					r[i] = (T)(unsigned char)red;
+					g[i] = (T)(unsigned char)green;
+				}
+
+				this->classifyRow(r,g,b,256,row);
+
+				// 256 bits are exactly 4 words of the table
+				uint64_t *words = &this->lookupTable[((red << 16) | (green << 8)) >> 6];
+
+				for (unsigned int i = 0; i < 256; i++)
+				{
+					words[i >> 6] |= (uint64_t)row[i] << (i & 63);
+				}
+			}
+		};
+
+		ThreadPool *pool = this->threadPoolInstance();
+
+		if (pool)
+		{
+			pool->parallelFor(256, buildRed);
+		}
+		else
+		{
+			for (unsigned int red = 0; red < 256; red++)
+			{
+				buildRed(red);
+			}
+		}
+
+		this->lookupTableValid = true;
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::growShrinkAlgorithm( CImg<bool> *img, const unsigned int count, const unsigned int size )
+	{
+		for (unsigned int i = 0; i < count; i++ )
+		{
+			if (this->applyGrowBeforeShrink)
+			{
+				this->growAlgorithm(img, 1, size);
+				this->shrinkAlgorithm(img, 1, size);
+			}
+			else
+			{				
+				this->shrinkAlgorithm(img, 1, size);
+				this->growAlgorithm(img, 1, size);
+			}
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::growAlgorithm( CImg<bool> *img, const unsigned int count, const unsigned int size)
+	{
+		if (morphology::matchesCImg(*img, size))
+		{
+			// All count dilations are done at once on the packed mask with a window that is count times as wide
+			BinaryMask &packed = this->workspace.packedMask(img);
+			packed.assign(*img);
+			packed.dilate(size, count);
+			packed.toCImg(*img);
+			return;
+		}
+
+		for(unsigned int i = 0; i < count; i++)
+		{
+			img->dilate(size);
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::shrinkAlgorithm( CImg<bool> *img, const unsigned int count, const unsigned int size)
+	{
+		if (morphology::matchesCImg(*img, size))
+		{
+			// All count erosions are done at once on the packed mask with a window that is count times as wide
+			BinaryMask &packed = this->workspace.packedMask(img);
+			packed.assign(*img);
+			packed.erode(size, count);
+			packed.toCImg(*img);
+			return;
+		}
+
+		for(unsigned int i = 0; i < count; i++)
+		{
+			img->erode(size);
+		}
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::labelRegions( const CImg<bool> &img, const ImageView<T> *colors )
+	{
+		const unsigned int width = img.width();
+		const unsigned int height = img.height();
+
+		this->labelMask.assign(width,height,1,1,0);
+		this->regionCount = 0;
+		this->biggestRegion = 0;
+
+		// The mask is split into horizontal bands that are labeled independently (a single band covering the whole mask if it is labeled serially)
+		ThreadPool *pool = this->threadPoolInstance();
+		const unsigned int bandCount = pool ? std::max(1u, std::min<unsigned int>(pool->size(), height)) : 1;
+
+		// The sizes, last pixels and statistics of the local labels are kept in the workspace, so they keep their memory for the next image
+		Workspace<T> &ws = this->workspace;
+		ws.reserveBands(bandCount);
+
+		const bool statistics = this->collectRegionStatistics;
+
+		if (!statistics)
+		{
+			this->regionTable.clear();
+		}
+
+		auto labelBandTask = [&](unsigned int band)
+		{
+			typename Workspace<T>::Band &buffers = ws.band(band);
+			buffers.regionCount = this->labelBand(img, band * height / bandCount, (band + 1) * height / bandCount, buffers.sizes, buffers.lastPixels,
+				statistics ? &buffers.regions : 0, colors);
+		};
+
+		std::vector<unsigned int> &lastPixel = ws.lastPixel;
 
-			if (adjX < 0 || adjY < 0)
+		if (bandCount == 1)
+		{
+			labelBandTask(0);
+
+			this->regionCount = ws.band(0).regionCount;
+			this->regionSizes.swap(ws.band(0).sizes);
+			lastPixel.swap(ws.band(0).lastPixels);
+
+			if (statistics)
 			{
-				continue;
+				this->regionTable.swap(ws.band(0).regions);
+			}
+		}
+		else
+		{
+			pool->parallelFor(bandCount, std::ref(labelBandTask));
+
+			// The local labels of all bands are numbered consecutively (in raster order of their first pixel) to get provisional global labels
+			std::vector<unsigned int> &offsets = ws.offsets;
+			offsets.assign(bandCount + 1, 0);
+
+			for (unsigned int band = 0; band < bandCount; band++)
+			{
+				offsets[band + 1] = offsets[band] + ws.band(band).regionCount;
+			}
+
+			// Union-find over the provisional labels, the root of a region is always its provisional label with the smallest number
+			std::vector<unsigned int> &parent = ws.parent;
+			parent.resize(offsets[bandCount] + 1);
+
+			for (unsigned int label = 0; label <= offsets[bandCount]; label++)
+			{
+				parent[label] = label;
 			}
 
-			// If there is a skin pixel at the adjacent position
-			if ((*img)(adjX,adjY,0,0))
+			auto findRoot = [&parent](unsigned int label) -> unsigned int
 			{
+				while (parent[label] != label)
+				{
+					parent[label] = parent[parent[label]];
+					label = parent[label];
+				}
+
+				return label;
+			};
 
-				unsigned int adjacentLabel = this->labelMask(adjX,adjY,0,0);
-				unsigned int ownLabel = this->labelMask(x,y,0,0);
+			// Merges the labels of the regions that touch each other across the border between two bands
+			const unsigned int *labels = this->labelMask.data();
+
+			for (unsigned int band = 1; band < bandCount; band++)
+			{
+				const unsigned int y = band * height / bandCount;
 
-				// Compares the two labels and if they are not equal determines which one is smaller in number
-				// Then the data of the bigger Label will be transferred to the smaller Label
-				if (adjacentLabel != ownLabel)
+				for (unsigned int x = 0; x < width; x++)
 				{
-					unsigned int smallerLabel;
-					unsigned int biggerLabel;
+					const unsigned int p = y * width + x;
 
-					if (adjacentLabel < ownLabel)
+					if (labels[p] == 0)
 					{
-						smallerLabel = adjacentLabel;
-						biggerLabel = ownLabel;
+						continue;
 					}
-					else
+
+					const unsigned int ownLabel = findRoot(labels[p] + offsets[band]);
+
+					for (unsigned int adjX = (x > 0 ? x - 1 : 0); adjX <= x + 1 && adjX < width; adjX++)
 					{
-						smallerLabel = ownLabel;
-						biggerLabel = adjacentLabel;
+						const unsigned int adjacent = labels[p - width - x + adjX];
+
+						if (adjacent != 0)
+						{
+							const unsigned int adjacentLabel = findRoot(adjacent + offsets[band - 1]);
+							const unsigned int ownRoot = findRoot(ownLabel);
+
+							if (adjacentLabel < ownRoot)
+							{
+								parent[ownRoot] = adjacentLabel;
+							}
+							else if (ownRoot < adjacentLabel)
+							{
+								parent[adjacentLabel] = ownRoot;
+							}
+						}
 					}
+				}
+			}
+
+			// Final labels are assigned in the order of the roots, which gives the same labels as the serial labeling
+			std::vector<unsigned int> &finalLabels = ws.finalLabels;
+			finalLabels.assign(offsets[bandCount] + 1, 0);
+			this->regionSizes.assign(1,0);
+			lastPixel.assign(1,0);
+
+			if (statistics)
+			{
+				this->regionTable.clear();
+			}
+
+			for (unsigned int band = 0; band < bandCount; band++)
+			{
+				const typename Workspace<T>::Band &buffers = ws.band(band);
 
-					// Retrieves all the coordinates of the pixels of the bigger label
-					std::vector<Point2D> *positionVect = &(this->labeledPixels.at(biggerLabel));
+				for (unsigned int local = 1; local <= buffers.regionCount; local++)
+				{
+					const unsigned int label = local + offsets[band];
+					const unsigned int root = findRoot(label);
 
-					// Changes the labels of the pixels of the bigger label to the new labels on the temporary label mask
-					for (unsigned int i = 0; i < positionVect->size();i++)
+					if (root == label)
 					{
-						Point2D *posPoint = &(positionVect->at(i));
+						finalLabels[label] = ++this->regionCount;
+						this->regionSizes.push_back(0);
+						lastPixel.push_back(0);
 
-						this->labelMask(posPoint->x,posPoint->y,0,0) = smallerLabel;							
+						if (statistics)
+						{
+							this->regionTable.push();
+						}
+					}
+					else
+					{
+						finalLabels[label] = finalLabels[root];
 					}
 
-					// Adjusts the new region sizes
-					this->regionSizes.at(smallerLabel) += this->regionSizes.at(biggerLabel);
-					this->regionSizes.at(biggerLabel) = 0;
+					this->regionSizes[finalLabels[label]] += buffers.sizes[local];
+					lastPixel[finalLabels[label]] = std::max(lastPixel[finalLabels[label]], buffers.lastPixels[local]);
 
-					// Transfers the pixel coordinates of the bigger label to the vector of the smaller label
-					for(unsigned int i = 0; i < positionVect->size();i++)
+					if (statistics)
 					{
-						this->labeledPixels.at(smallerLabel).push_back(positionVect->at(i));
+						this->regionTable.merge(finalLabels[label] - 1, buffers.regions, local - 1);
 					}
+				}
+			}
+
+			if (this->recordingStatistics)
+			{
+				this->lastStatistics.labelMerges += offsets[bandCount] - this->regionCount;
+			}
 
-					this->labeledPixels.at(biggerLabel).clear();
+			// Replaces the local labels by the final labels
+			auto relabelBand = [&](unsigned int band)
+			{
+				unsigned int *bandLabels = this->labelMask.data() + (size_t)(band * height / bandCount) * width;
+				unsigned int *bandEnd = this->labelMask.data() + (size_t)((band + 1) * height / bandCount) * width;
 
-					// Determines if the smaller Label is now (after the fusion) the currently biggest region in the bit mask
-					if (this->regionSizes.at(smallerLabel) > this->regionSizes.at(this->biggestRegion))
+				for (; bandLabels != bandEnd; bandLabels++)
+				{
+					if (*bandLabels != 0)
 					{
-						this->biggestRegion = smallerLabel;
+						*bandLabels = finalLabels[*bandLabels + offsets[band]];
 					}
 				}
+			};
+
+			pool->parallelFor(bandCount, std::ref(relabelBand));
+		}
+
+		// The sums of the statistics become means and central moments
+		if (statistics)
+		{
+			this->regionTable.finish();
+		}
+
+		// Like the previous labeling, ties between equally big regions are decided in favor of the region that is complete first in raster order
+		for (unsigned int label = 1; label <= this->regionCount; label++)
+		{
+			if (this->biggestRegion == 0 || this->regionSizes[label] > this->regionSizes[this->biggestRegion]
+				|| (this->regionSizes[label] == this->regionSizes[this->biggestRegion] && lastPixel[label] < lastPixel[this->biggestRegion]))
+			{
+				this->biggestRegion = label;
 			}
 		}
 	}
 
 	template<typename T>
-	void lime::Algorithm<T>::deleteMinorRegions( CImg<bool> *img )
+	unsigned int lime::Algorithm<T>::labelBand( const CImg<bool> &img, unsigned int y0, unsigned int y1, std::vector<unsigned int> &sizes, std::vector<unsigned int> &lastPixel,
+		RegionTable *regions, const ImageView<T> *colors )
 	{
-		// Goes through the labelPixels vector which stores for each label an inner vector with all the coordinates of the pixels belonging to the label.
-		for (unsigned int i = 0; i < this->labeledPixels.size();i++)
+		const unsigned int width = img.width();
+		const bool *mask = img.data();
+
+		// In the first pass every skin pixel stores the linear index + 1 of its parent in labelMask (0 = no skin, own index + 1 = root).
+		// Trees are always linked below the root with the smaller index, so every parent comes before its children in raster order.
+		unsigned int *parent = this->labelMask.data();
+
+		// Returns the root of a tree and points all pixels on the way directly to it
+		auto findRoot = [parent](unsigned int label) -> unsigned int
 		{
-			// Continues if this region is the biggest region or completely empty
-			if (this->biggestRegion == i || this->regionSizes.at(i) == 0)
+			unsigned int root = label;
+
+			while (parent[root - 1] != root)
 			{
-				continue;
+				root = parent[root - 1];
+			}
+
+			while (parent[label - 1] != root)
+			{
+				const unsigned int next = parent[label - 1];
+				parent[label - 1] = root;
+				label = next;
+			}
+
+			return root;
+		};
+
+		// Merges the trees of two labels
+		auto unite = [parent,&findRoot](unsigned int a, unsigned int b)
+		{
+			a = findRoot(a);
+			b = findRoot(b);
+
+			if (a < b)
+			{
+				parent[b - 1] = a;
+			}
+			else if (b < a)
+			{
+				parent[a - 1] = b;
+			}
+		};
+
+		for (unsigned int y = y0; y < y1; y++)
+		{
+			for (unsigned int x = 0; x < width; x++)
+			{
+				const unsigned int p = y * width + x;
+
+				if (!mask[p])
+				{
+					continue;
+				}
+
+				parent[p] = p + 1;
+
+				// Compare with the adjacent pixels of the band that are already labeled (left-up, left, up, right-up)
+				if (x > 0 && mask[p - 1])
+				{
+					unite(p + 1, p);
+				}
+
+				if (y > y0)
+				{
+					if (x > 0 && mask[p - width - 1])
+					{
+						unite(p + 1, p - width);
+					}
+
+					if (mask[p - width])
+					{
+						unite(p + 1, p - width + 1);
+					}
+
+					if (x + 1 < width && mask[p - width + 1])
+					{
+						unite(p + 1, p - width + 2);
+					}
+				}
 			}
+		}
+
+		// The second pass replaces the parents by consecutive labels. Parents come first, so their final label is already known.
+		// If statistics are collected, every pixel is added to the sums of its label in the same pass.
+		unsigned int count = 0;
+		sizes.assign(1,0);
+		lastPixel.assign(1,0);
 
-			// Otherwise the coordinate informations are used to set all pixels in the bit mask to false
-			for (unsigned int j = 0; j < this->labeledPixels.at(i).size();j++)
+		if (regions)
+		{
+			regions->clear();
+		}
+
+		const unsigned int step = colors ? colors->pixelStep() : 0;
+
+		for (unsigned int y = y0; y < y1; y++)
+		{
+			const T *red = colors ? colors->row(0,y) : 0;
+			const T *green = colors ? colors->row(1,y) : 0;
+			const T *blue = colors ? colors->row(2,y) : 0;
+
+			for (unsigned int x = 0, p = y * width; x < width; x++, p++)
 			{
-				Point2D *posPoint = &this->labeledPixels.at(i).at(j);
+				if (!mask[p])
+				{
+					continue;
+				}
+
+				unsigned int label;
+
+				if (parent[p] == p + 1)
+				{
+					label = ++count;
+					sizes.push_back(0);
+					lastPixel.push_back(0);
+
+					if (regions)
+					{
+						regions->push();
+					}
+				}
+				else
+				{
+					label = parent[parent[p] - 1];
+				}
+
+				parent[p] = label;
+				sizes[label]++;
+				lastPixel[label] = p;
+
+				if (regions)
+				{
+					regions->add(label - 1, x, y);
+
+					if (colors)
+					{
+						regions->addColor(label - 1, red[x * step], green[x * step], blue[x * step]);
+					}
+				}
+			}
+		}
+
+		return count;
+	}
+
+	template<typename T>
+	void lime::Algorithm<T>::deleteMinorRegions( CImg<bool> *img )
+	{
+		// The labels belong to the last labeled bit mask
+		if (img->width() != this->labelMask.width() || img->height() != this->labelMask.height())
+		{
+			return;
+		}
+
+		const unsigned int *labels = this->labelMask.data();
+		bool *mask = img->data();
 
-				(*img)(posPoint->x,posPoint->y,0,0) = false;
+		// Sets all pixels of a labeled region that is not the biggest region to false
+		for (unsigned int p = 0; p < this->labelMask.size(); p++)
+		{
+			if (labels[p] != 0 && labels[p] != this->biggestRegion)
+			{
+				mask[p] = false;
 			}
 		}
 	}
@@ -611,7 +1970,8 @@ namespace lime{
 	std::vector<BinarySeed>* lime::Algorithm<T>::getSeeds( bool skin, bool singleRegion, const CImg<bool> &mask, bool applyRegionChange, unsigned int regionChangeCount, unsigned int regionChangeSize )
 	{
 		std::vector<BinarySeed> *resVector = new std::vector<BinarySeed>;
-		CImg<bool> maskCopy(mask);
+		CImg<bool> &maskCopy = this->workspace.maskCopy;
+		maskCopy = mask;
 
 		// Pre-Processing of the data of the mask (grow or shrink algorithm)
 		if (applyRegionChange)
@@ -628,7 +1988,8 @@ namespace lime{
 
 		//Processing part
 
-		CImg<bool> visitedMask(maskCopy.width(),maskCopy.height(),1,1, false); // tracks which pixels were visited if the singleRegion algorithm is used
+		CImg<bool> &visitedMask = this->workspace.visited; // tracks which pixels were visited if the singleRegion algorithm is used
+		visitedMask.assign(maskCopy.width(),maskCopy.height(),1,1, false);
 		std::queue<Point2D> pixelQueue; // Queue of the pixels that should be evaluated next if the singleRegion algorithm is used
 
 		unsigned int width = maskCopy.width();
@@ -636,52 +1997,44 @@ namespace lime{
 
 		bool initPixel = false; // Only important if the singleRegion algorithm is used. True when a first suitable pixel has been detected
 
-		// Loops through all pixels (if singleRegion isn't used) or just until the first suitable pixel has been detected (singleRegion algorithm)
-		CImg_3x3(I, bool);
-		cimg_for3x3(maskCopy, x, y, 0, 0, I, bool) 
+		// Seed pixels are the skin pixels with a non-skin neighbor (or the other way around), they are detected word by word on the packed mask
+		BinaryMask &packedMask = this->workspace.packed;
+		packedMask.assign(maskCopy);
+		BinaryMask &border = this->workspace.boundary;
+
+		if (skin)
 		{
-			if (initPixel && singleRegion)
-			{
-				// If the first suitable pixel has been detected (singleRegion algorithm) the loop will be canceled
-				goto singleRegionJump;
-			}
+			packedMask.getBoundary(border);
+		}
+		else
+		{
+			packedMask.getOuterBoundary(border);
+		}
 
-			if (skin)
-			{
-				// True if the center pixel is a skin pixel and one of the neighbor pixels is non-skin
-				if (Icc && !(Ipp & Icp & Inp & Ipc & Inc & Ipn & Icn & Inn))
-				{
-					BinarySeed seed(x,y,true);
-					resVector->push_back(seed);
+		if (singleRegion)
+		{
+			// Only the first suitable pixel is taken, the rest of the region is found by the search over the neighbor pixels
+			unsigned int x, y;
 
-					if (singleRegion)
-					{
-						pixelQueue.push(Point2D(x,y));
-						visitedMask(x,y,0,0) = true;
-						initPixel = true;
-					}
-				}
-			}
-			else
+			if (border.findFirst(x,y))
 			{
-				// True if the center pixel is a non-skin pixel and one of the neighbor pixels is skin
-				if (!Icc && (Ipp | Icp | Inp | Ipc | Inc | Ipn | Icn | Inn))
-				{
-					BinarySeed seed(x,y,true);
-					resVector->push_back(seed);
-
-					if (singleRegion)
-					{
-						pixelQueue.push(Point2D(x,y));
-						visitedMask(x,y,0,0) = true;
-						initPixel = true;
-					}
-				}
+				BinarySeed seed(x,y,true);
+				resVector->push_back(seed);
+				pixelQueue.push(Point2D(x,y));
+				visitedMask(x,y,0,0) = true;
+				initPixel = true;
 			}
 		}
+		else
+		{
+			// All suitable pixels in raster order
+			border.forEachPixel([resVector](unsigned int x, unsigned int y)
+			{
+				resVector->push_back(BinarySeed(x,y,true));
+			});
+		}
 
 		// for the single Region a search over the neighbor pixels is performed
-singleRegionJump: 
 		if (singleRegion && initPixel)
 		{
 			Point2D point;
@@ -782,131 +2135,93 @@ singleRegionJump:
 	}
 
 	template<typename T>
-	CImg<int>* lime::Algorithm<T>::getDistanceMapOfMask( CImg<bool> &mask, bool singleRegion )
+	void lime::Algorithm<T>::getContourSeeds( bool skin, bool singleRegion, const CImg<bool> &mask, bool applyRegionChange, unsigned int regionChangeCount, unsigned int regionChangeSize,
+		unsigned int stride, std::vector<BinarySeed> &seeds, std::vector<contour::Contour> &contours )
 	{
+		const CImg<bool> *source = &mask;
 
-		CImg<bool> maskCopy(mask);
-
-		// Phase 1: Sorting the pixels into three different categories (seed, internal, external)
-		std::vector<BinarySeed> seeds;
-
-		std::vector<Point2D> internal;
-
-		std::vector<Point2D> external;
-
-		// Deletes all minor regions if just a single region should be detected
-		if (singleRegion)
-		{
-			deleteMinorRegions(&maskCopy);
-		}
-
-		unsigned int width = maskCopy.width();
-		unsigned int height = maskCopy.height();
-
-		// Loops through all pixels
-		CImg_3x3(I, bool);
-		cimg_for3x3(maskCopy, x, y, 0, 0, I, bool) 
+		// Pre-Processing of the data of the mask (grow or shrink algorithm)
+		if (applyRegionChange)
 		{
+			CImg<bool> &maskCopy = this->workspace.maskCopy;
+			maskCopy = mask;
 
-			if (Icc)
+			if (skin)
 			{
-				// True if the center pixel is a skin pixel and one of the neighbor pixels is non-skin
-				if (!(Ipp & Icp & Inp & Ipc & Inc & Ipn & Icn & Inn))
-				{
-					BinarySeed seed(x,y,true);
-					seeds.push_back(seed);
-				} 
-				else // Center pixel and all surrounding pixels are skin
-				{
-					internal.push_back(Point2D(x,y));
-				}
+				this->shrinkAlgorithm(&maskCopy, regionChangeCount,regionChangeSize);
 			}
-			else // Center pixel is a non-skin pixel
+			else
 			{
-				external.push_back(Point2D(x,y));
+				this->growAlgorithm(&maskCopy, regionChangeCount,regionChangeSize);
 			}
-		}
 
-		// Phase 2: Preparation for the FLANN search algorithm
-
-		unsigned int numb_seeds = seeds.size();
-		unsigned int numb_int = internal.size();
-		unsigned int numb_ext = external.size();
+			source = &maskCopy;
+		}
 
-		// The OpenCV matrices that store the different points as x y
-		cv::Mat_<double> contourPoints(numb_seeds,2);
-		cv::Mat_<double> internalPoints(numb_int,2);
-		cv::Mat_<double> externalPoints(numb_ext,2);
+		contour::traceContours(*source, skin, singleRegion, stride, seeds, contours, this->workspace.contours);
+	}
 
-		// Matrices getting filled
+	template<typename T>
+	CImg<int>* lime::Algorithm<T>::getDistanceMapOfMask( CImg<bool> &mask, bool singleRegion )
+	{
 
-		for (unsigned int i = 0; i < seeds.size();i++)
-		{
-			contourPoints[i][0] = seeds[i].x;
-			contourPoints[i][1] = seeds[i].y;
-		}
+		CImg<bool> &maskCopy = this->workspace.maskCopy;
+		maskCopy = mask;
 
-		for (unsigned int i = 0; i < internal.size();i++)
+		// Deletes all minor regions if just a single region should be detected
+		if (singleRegion)
 		{
-			internalPoints[i][0] = internal[i].x;
-			internalPoints[i][1] = internal[i].y;
+			deleteMinorRegions(&maskCopy);
 		}
 
-		for (unsigned int i = 0; i < external.size();i++)
-		{
-			externalPoints[i][0] = external[i].x;
- 			externalPoints[i][1] = external[i].y;
-		}
+		CImg<int> *map = new CImg<int>(maskCopy.width(),maskCopy.height(),1,1,(int)0);
 
-		int a = 5;
-		// Initialization of the search tree
+		// The contour pixels are the skin pixels with at least one non-skin neighbor, all distances are measured to them
+		BinaryMask &packedMask = this->workspace.packed;
+		packedMask.assign(maskCopy);
+		BinaryMask &contour = this->workspace.boundary;
+		packedMask.getBoundary(contour);
 
-		SearchTree st(contourPoints,cvflann::KDTreeIndexParams(5));
+		unsigned int firstX, firstY;
 
-		// Phase 3: Retrieving the distances
+		if (!contour.findFirst(firstX, firstY))
+		{
+			return map;
+		}
 
-		cv::Mat_<double> internalDistances = this->findDistances(st,internalPoints);
-		cv::Mat_<double> externalDistances = this->findDistances(st, externalPoints);
+		ThreadPool *pool = this->threadPoolInstance();
 
-		// Phase 4: Construction of the distance Map
+		distance::squaredDistanceTransform(contour, *map, pool, &this->workspace.distances);
 
-		CImg<int> *map = new CImg<int>(maskCopy.width(),maskCopy.height(),1,1,(int)0);
+		// Inner pixels get negative distances (the contour pixels themselves stay 0)
+		const unsigned int bandCount = pool ? std::max(1u, std::min<unsigned int>(pool->size(), maskCopy.height())) : 1;
 
-		for (unsigned int i = 0; i < internal.size();i++)
+		auto signBand = [&](unsigned int band)
 		{
-			int tempX = *internalDistances[i];
-			unsigned int x = internal[i].x;
-			unsigned int y = internal[i].y;
+			const size_t begin = (size_t)(band * maskCopy.height() / bandCount) * maskCopy.width();
+			const size_t end = (size_t)((band + 1) * maskCopy.height() / bandCount) * maskCopy.width();
+			const bool *skin = maskCopy.data();
+			int *dist = map->data();
 
-			int dist = static_cast<unsigned int>(*internalDistances[i]) * (-1);
+			for (size_t i = begin; i < end; i++)
+			{
+				if (skin[i])
+				{
+					dist[i] = -dist[i];
+				}
+			}
+		};
 
-			(*map)(x,y,0,0) = dist;
+		if (pool)
+		{
+			pool->parallelFor(bandCount, std::ref(signBand));
 		}
-
-		for (unsigned int i = 0; i < external.size();i++)
+		else
 		{
-			unsigned int x = external[i].x;
-			unsigned int y = external[i].y;
-
-			int dist = *externalDistances[i];
-
-			(*map)(x,y,0,0) = dist;
+			signBand(0);
 		}
 
 		return map;
 	}
-	template<typename T>
-	cv::Mat_<double> lime::Algorithm<T>::findDistances(SearchTree& st, const cv::Mat_<double>& queryPoints )
-	{
-		// what we need for K nearest points search ( here K=1 )
-		cv::Mat_<int> nearestIndices( queryPoints.rows, 1 ); // 1D matrix to store the indices of the K-nearest points
-		cv::Mat_<double> nearestDistances( queryPoints.rows, 1 ); // 1D matrix to store the distances to the K-nearest points
-
-		// run the search
-		st.knnSearch(queryPoints,nearestIndices,nearestDistances,1,cvflann::SearchParams(128));
-
-		return nearestDistances;
-
-	}
 
 }
\ No newline at end of file
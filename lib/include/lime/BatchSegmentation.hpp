@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file BatchSegmentation.hpp
+/// @brief Contains the BatchSegmentation class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/Segmentation.hpp>
+#include <lime/BoundedQueue.hpp>
+#include <CImg.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+using namespace cimg_library;
+
+namespace lime
+{
+
+///
+/// @class BatchSegmentation
+///
+/// @version 0.3.0
+///
+/// @brief Segments a list of image files with decoding, segmentation and encoding running concurrently as the stages of a pipeline.
+///
+/// @details The decoder threads load the images, the calling thread segments them (using the thread pool of the algorithm if it has one) and the
+/// encoder threads store the masks. The stages are connected by bounded queues, so at most a fixed number of decoded images and masks are in
+/// memory at the same time and the file access and the codecs are hidden behind the segmentation. The masks are encoded in the order in which the
+/// images finished decoding, which is only the order of the list if a single decoder thread is used.
+/// An image that cannot be decoded, segmented or encoded is recorded in Failures() and the batch goes on with the next one.
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - Can be of any basic data type and should be the same as the one of the input image (e.g. double or char).
+///
+template<typename T = int> class BatchSegmentation : public Segmentation<T>
+{
+
+public:
+
+	///
+	/// @brief Loads the image with the given path and returns it (or 0 if it cannot be loaded). Exceptions count as a failure as well.
+	///
+	typedef std::function<CImg<T>*(const std::string&)> Decoder;
+
+	///
+	/// @brief Stores the mask of the image with the given path. Exceptions count as a failure.
+	///
+	typedef std::function<void(const std::string&, const CImg<bool>&)> Encoder;
+
+	///
+	/// @brief The constructor of BatchSegmentation that needs a skin segmentation algorithm passed to (Strategy pattern)
+	/// @param _algorithm The algorithm that is used to process the images
+	/// @param _queueCapacity The number of images (and masks) that can wait between two stages
+	/// @param _decoderThreads The number of threads that decode images
+	/// @param _encoderThreads The number of threads that encode masks
+	///
+	BatchSegmentation(Algorithm<T>* _algorithm, unsigned int _queueCapacity = 4, unsigned int _decoderThreads = 1, unsigned int _encoderThreads = 1)
+		:Segmentation<T>(_algorithm),queueCapacity(std::max(1u, _queueCapacity)),decoderThreads(std::max(1u, _decoderThreads)),encoderThreads(std::max(1u, _encoderThreads)){}
+
+	///
+	/// @brief The basic destructor
+	///
+	virtual ~BatchSegmentation(){}
+
+	virtual unsigned int QueueCapacity() const { return queueCapacity; } ///< Returns the number of images (and masks) that can wait between two stages.
+	virtual void QueueCapacity(unsigned int val) { queueCapacity = std::max(1u, val); } ///< Can set the number of images (and masks) that can wait between two stages (bounds the memory of the pipeline).
+
+	virtual unsigned int DecoderThreads() const { return decoderThreads; } ///< Returns the number of threads that decode images.
+	virtual void DecoderThreads(unsigned int val) { decoderThreads = std::max(1u, val); } ///< Can set the number of threads that decode images.
+
+	virtual unsigned int EncoderThreads() const { return encoderThreads; } ///< Returns the number of threads that encode masks.
+	virtual void EncoderThreads(unsigned int val) { encoderThreads = std::max(1u, val); } ///< Can set the number of threads that encode masks.
+
+	///
+	/// @brief Returns the paths of the images of the last batch that could not be processed (in the order of the list).
+	///
+	inline const std::vector<std::string>& Failures() const { return failures; }
+
+	///
+	/// @brief The default decoder: loads the image with CImg and repeats the channel of grayscale images, so every image has the three channels the algorithms need.
+	///
+	static CImg<T>* decodeImage(const std::string &path)
+	{
+		CImg<T> *img = new CImg<T>();
+
+		try
+		{
+			loadImage(path, *img);
+		}
+		catch (...)
+		{
+			delete img;
+			throw;
+		}
+
+		if (img->spectrum() < 3)
+		{
+			img->channel(0).resize(-100,-100,-100,3,1);
+		}
+
+		return img;
+	}
+
+	///
+	/// @brief Segments all images of the list.
+	/// @param paths The paths of the images
+	/// @param encoder Stores the masks
+	/// @param decoder Loads the images
+	/// @return The number of images that were processed successfully
+	///
+	unsigned int process(const std::vector<std::string> &paths, const Encoder &encoder, const Decoder &decoder = &BatchSegmentation<T>::decodeImage);
+
+protected:
+
+	///
+	/// @brief An image or a mask on its way through the pipeline together with the index of its path
+	///
+	template<typename V> struct Item
+	{
+		std::size_t index;
+		CImg<V> *data;
+	};
+
+	///
+	/// @brief The number of images (and masks) that can wait between two stages
+	///
+	unsigned int queueCapacity;
+
+	///
+	/// @brief The number of threads that decode images
+	///
+	unsigned int decoderThreads;
+
+	///
+	/// @brief The number of threads that encode masks
+	///
+	unsigned int encoderThreads;
+
+	///
+	/// @brief The paths of the images of the last batch that could not be processed
+	///
+	std::vector<std::string> failures;
+
+};
+
+template<typename T>
+unsigned int lime::BatchSegmentation<T>::process( const std::vector<std::string> &paths, const Encoder &encoder, const Decoder &decoder )
+{
+	BoundedQueue<Item<T> > decoded(queueCapacity);
+	BoundedQueue<Item<bool> > segmented(queueCapacity);
+
+	std::atomic<std::size_t> nextPath(0);
+	std::atomic<unsigned int> activeDecoders(decoderThreads);
+	std::atomic<unsigned int> succeeded(0);
+
+	std::mutex failureMutex;
+	std::vector<std::size_t> failed;
+
+	auto fail = [&](std::size_t index)
+	{
+		std::lock_guard<std::mutex> lock(failureMutex);
+		failed.push_back(index);
+	};
+
+	// Decoding stage: every thread takes the next path of the list
+	std::vector<std::thread> threads;
+
+	for (unsigned int i = 0; i < decoderThreads; i++)
+	{
+		threads.push_back(std::thread([&]
+		{
+			for (std::size_t index = nextPath++; index < paths.size(); index = nextPath++)
+			{
+				Item<T> item = { index, 0 };
+
+				try
+				{
+					item.data = decoder(paths[index]);
+				}
+				catch (...)
+				{
+					item.data = 0;
+				}
+
+				if (item.data == 0)
+				{
+					fail(index);
+				}
+				else
+				{
+					decoded.push(item);
+				}
+			}
+
+			// The last decoder tells the segmentation stage that no more images follow
+			if (--activeDecoders == 0)
+			{
+				decoded.close();
+			}
+		}));
+	}
+
+	// Encoding stage
+	for (unsigned int i = 0; i < encoderThreads; i++)
+	{
+		threads.push_back(std::thread([&]
+		{
+			Item<bool> item;
+
+			while (segmented.pop(item))
+			{
+				try
+				{
+					encoder(paths[item.index], *item.data);
+					succeeded++;
+				}
+				catch (...)
+				{
+					fail(item.index);
+				}
+
+				delete item.data;
+			}
+		}));
+	}
+
+	// Segmentation stage on the calling thread
+	Item<T> image;
+
+	while (decoded.pop(image))
+	{
+		Item<bool> mask = { image.index, 0 };
+
+		try
+		{
+			mask.data = this->retrieveMask_asBinaryChannel(*image.data);
+		}
+		catch (...)
+		{
+			mask.data = 0;
+		}
+
+		delete image.data;
+
+		if (mask.data == 0)
+		{
+			fail(image.index);
+		}
+		else
+		{
+			segmented.push(mask);
+		}
+	}
+
+	segmented.close();
+
+	for (unsigned int i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+
+	std::sort(failed.begin(), failed.end());
+
+	failures.clear();
+
+	for (unsigned int i = 0; i < failed.size(); i++)
+	{
+		failures.push_back(paths[failed[i]]);
+	}
+
+	return succeeded;
+}
+
+} // end namespace lime
@@ -0,0 +1,505 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file BinaryMask.hpp
+/// @brief Contains the BinaryMask class, a bit mask with one bit per pixel
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/Morphology.hpp>
+#include <CImg.h>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace lime
+{
+
+///
+/// @class BinaryMask
+///
+/// @version 0.3.0
+///
+/// @brief A bit mask that stores 64 pixels in one word (8 times less memory than CImg<bool>).
+///
+/// @details Every row starts at a new word, bit i of word k of a row is the pixel x = 64*k + i and the bits behind the last pixel of a row
+/// are always zero. Erosion and dilation work on whole words with shifts, AND and OR and use the same kernel anchors and the same clipping at the
+/// border as the grow / shrink algorithms (CImg::erode / CImg::dilate), so a mask can be converted from a CImg<bool>, processed and converted back.
+///
+/// @date Oct 16, 2026 - First creation
+/// @date Oct 16, 2026 - The buffers of erode / dilate are kept, so a reused mask does not allocate memory for masks of the same size
+///
+class BinaryMask
+{
+
+public:
+
+	///
+	/// @brief Creates an empty mask
+	///
+	BinaryMask():_width(0),_height(0),_stride(0){}
+
+	///
+	/// @brief Creates a mask of the given size with all pixels set to value
+	///
+	BinaryMask(unsigned int width, unsigned int height, bool value = false):_width(0),_height(0),_stride(0)
+	{
+		assign(width, height, value);
+	}
+
+	///
+	/// @brief Packs the first channel of a CImg<bool>
+	///
+	explicit BinaryMask(const cimg_library::CImg<bool> &img):_width(0),_height(0),_stride(0)
+	{
+		assign(img);
+	}
+
+	///
+	/// @brief Resizes the mask and sets all pixels to value
+	///
+	void assign(unsigned int width, unsigned int height, bool value = false)
+	{
+		_width = width;
+		_height = height;
+		_stride = (width + 63) / 64;
+		words.assign((size_t)_stride * height, value ? ~(uint64_t)0 : 0);
+
+		if (value)
+		{
+			clearPadding();
+		}
+	}
+
+	///
+	/// @brief Empties the mask and gives back its memory (including the buffers of erode / dilate)
+	///
+	void release()
+	{
+		_width = _height = _stride = 0;
+		std::vector<uint64_t>().swap(words);
+		std::vector<uint64_t>().swap(run);
+		std::vector<uint64_t>().swap(shifted);
+		forward.assign();
+		backward.assign();
+	}
+
+	///
+	/// @brief Packs the first channel of a CImg<bool>
+	///
+	void assign(const cimg_library::CImg<bool> &img)
+	{
+		assign(img.width(), img.height());
+
+		for (unsigned int y = 0; y < _height; y++)
+		{
+			const bool *src = img.data(0,y,0,0);
+			uint64_t *dst = row(y);
+
+			for (unsigned int x = 0; x < _width; x += 64)
+			{
+				const unsigned int count = std::min(64u, _width - x);
+				uint64_t word = 0;
+
+				for (unsigned int i = 0; i < count; i++)
+				{
+					word |= (uint64_t)(src[x + i] ? 1 : 0) << i;
+				}
+
+				dst[x / 64] = word;
+			}
+		}
+	}
+
+	///
+	/// @brief Unpacks the mask into a CImg<bool> with one channel
+	///
+	void toCImg(cimg_library::CImg<bool> &img) const
+	{
+		img.assign(_width, _height, 1, 1);
+
+		for (unsigned int y = 0; y < _height; y++)
+		{
+			const uint64_t *src = row(y);
+			bool *dst = img.data(0,y,0,0);
+
+			for (unsigned int x = 0; x < _width; x++)
+			{
+				dst[x] = ((src[x / 64] >> (x % 64)) & 1) != 0;
+			}
+		}
+	}
+
+	///
+	/// @brief Returns the mask as a new CImg<bool> with one channel
+	///
+	cimg_library::CImg<bool> toCImg() const
+	{
+		cimg_library::CImg<bool> img;
+		toCImg(img);
+		return img;
+	}
+
+	inline unsigned int width() const { return _width; } ///< Returns the width of the mask
+	inline unsigned int height() const { return _height; } ///< Returns the height of the mask
+	inline unsigned int stride() const { return _stride; } ///< Returns the number of words per row
+	inline bool isEmpty() const { return _width == 0 || _height == 0; } ///< Returns true if the mask has no pixels
+
+	///
+	/// @brief Returns the number of bytes held by the mask (pixels and the buffers of erode / dilate)
+	///
+	std::size_t footprint() const
+	{
+		return (words.capacity() + run.capacity() + shifted.capacity()) * sizeof(uint64_t) + (forward.size() + backward.size()) * sizeof(uint64_t);
+	}
+
+	inline uint64_t* row(unsigned int y) { return &words[(size_t)y * _stride]; } ///< Returns the words of a row
+	inline const uint64_t* row(unsigned int y) const { return &words[(size_t)y * _stride]; } ///< Returns the words of a row
+
+	inline bool get(unsigned int x, unsigned int y) const { return ((row(y)[x / 64] >> (x % 64)) & 1) != 0; } ///< Returns the value of a pixel
+
+	///
+	/// @brief Sets the value of a pixel
+	///
+	inline void set(unsigned int x, unsigned int y, bool value)
+	{
+		uint64_t &word = row(y)[x / 64];
+		const uint64_t bit = (uint64_t)1 << (x % 64);
+		word = value ? (word | bit) : (word & ~bit);
+	}
+
+	///
+	/// @brief Returns the number of set pixels
+	///
+	unsigned long long area() const
+	{
+		unsigned long long count = 0;
+
+		for (size_t i = 0; i < words.size(); i++)
+		{
+			count += popcount(words[i]);
+		}
+
+		return count;
+	}
+
+	///
+	/// @brief Inverts all pixels
+	///
+	BinaryMask& invert()
+	{
+		for (size_t i = 0; i < words.size(); i++)
+		{
+			words[i] = ~words[i];
+		}
+
+		clearPadding();
+		return *this;
+	}
+
+	BinaryMask& operator&=(const BinaryMask &other) { for (size_t i = 0; i < words.size(); i++) words[i] &= other.words[i]; return *this; } ///< Pixel-wise AND with a mask of the same size
+	BinaryMask& operator|=(const BinaryMask &other) { for (size_t i = 0; i < words.size(); i++) words[i] |= other.words[i]; return *this; } ///< Pixel-wise OR with a mask of the same size
+	BinaryMask& andNot(const BinaryMask &other) { for (size_t i = 0; i < words.size(); i++) words[i] &= ~other.words[i]; return *this; } ///< Clears all pixels that are set in a mask of the same size
+
+	bool operator==(const BinaryMask &other) const { return _width == other._width && _height == other._height && words == other.words; } ///< Compares size and pixels
+	bool operator!=(const BinaryMask &other) const { return !(*this == other); } ///< Compares size and pixels
+
+	///
+	/// @brief Dilates the mask count times with a square kernel of the given size (same anchor and border handling as CImg::dilate).
+	///
+	BinaryMask& dilate(unsigned int size, unsigned int count = 1)
+	{
+		if (size > 1)
+		{
+			spread(count * (size - size / 2 - 1), count * (size / 2));
+		}
+
+		return *this;
+	}
+
+	///
+	/// @brief Erodes the mask count times with a square kernel of the given size (same anchor and border handling as CImg::erode).
+	///
+	BinaryMask& erode(unsigned int size, unsigned int count = 1)
+	{
+		if (size > 1)
+		{
+			// The windows are clipped at the border, so the erosion is the inverted dilation of the inverted mask
+			invert();
+			spread(count * (size / 2), count * (size - size / 2 - 1));
+			invert();
+		}
+
+		return *this;
+	}
+
+	///
+	/// @brief Returns the set pixels that have at least one unset pixel in their 8-neighborhood (the border is extended like in cimg_for3x3).
+	///
+	BinaryMask getBoundary() const
+	{
+		BinaryMask inner;
+		getBoundary(inner);
+		return inner;
+	}
+
+	///
+	/// @brief Writes the set pixels that have at least one unset pixel in their 8-neighborhood into inner (its memory is reused).
+	///
+	void getBoundary(BinaryMask &inner) const
+	{
+		inner.copyPixels(*this);
+		inner.invert();
+		inner.spread(1, 1);
+		inner &= *this;
+	}
+
+	///
+	/// @brief Returns the unset pixels that have at least one set pixel in their 8-neighborhood (the border is extended like in cimg_for3x3).
+	///
+	BinaryMask getOuterBoundary() const
+	{
+		BinaryMask outer;
+		getOuterBoundary(outer);
+		return outer;
+	}
+
+	///
+	/// @brief Writes the unset pixels that have at least one set pixel in their 8-neighborhood into outer (its memory is reused).
+	///
+	void getOuterBoundary(BinaryMask &outer) const
+	{
+		outer.copyPixels(*this);
+		outer.spread(1, 1);
+		outer.andNot(*this);
+	}
+
+	///
+	/// @brief Calls f(x,y) for every set pixel in raster order
+	///
+	template<typename F>
+	void forEachPixel(F f) const
+	{
+		for (unsigned int y = 0; y < _height; y++)
+		{
+			const uint64_t *src = row(y);
+
+			for (unsigned int k = 0; k < _stride; k++)
+			{
+				for (uint64_t word = src[k]; word != 0; word &= word - 1)
+				{
+					f(k * 64 + countTrailingZeros(word), y);
+				}
+			}
+		}
+	}
+
+	///
+	/// @brief Finds the first set pixel in raster order
+	/// @return false if no pixel is set
+	///
+	bool findFirst(unsigned int &x, unsigned int &y) const
+	{
+		for (size_t i = 0; i < words.size(); i++)
+		{
+			if (words[i] != 0)
+			{
+				y = (unsigned int)(i / _stride);
+				x = (unsigned int)(i % _stride) * 64 + countTrailingZeros(words[i]);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	///
+	/// @brief Returns the number of set bits of a word
+	///
+	static inline unsigned int popcount(uint64_t word)
+	{
+#if defined(__GNUC__)
+		return (unsigned int)__builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		return (unsigned int)__popcnt64(word);
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return (unsigned int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	///
+	/// @brief Returns the index of the lowest set bit of a word (which must not be 0)
+	///
+	static inline unsigned int countTrailingZeros(uint64_t word)
+	{
+#if defined(__GNUC__)
+		return (unsigned int)__builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return (unsigned int)index;
+#else
+		return popcount((word & (0 - word)) - 1);
+#endif
+	}
+
+private:
+
+	///
+	/// @brief Sets every pixel to the OR of the window [x - before, x + after] x [y - before, y + after] (clipped at the border).
+	///
+	void spread(unsigned int before, unsigned int after)
+	{
+		if (isEmpty() || before + after == 0)
+		{
+			return;
+		}
+
+		const unsigned int length = before + after + 1;
+
+		// Along X-axis: every row is copied into a buffer with before zero pixels in front of it, so the window of pixel x becomes the run
+		// [x, x + length - 1] of the buffer. A run of length 2k is the OR of two runs of length k, a run of any other length the OR of two overlapping runs.
+		const unsigned int paddedWords = (_width + before + after + 63) / 64;
+		run.resize(paddedWords);
+		shifted.resize(paddedWords);
+
+		for (unsigned int y = 0; y < _height; y++)
+		{
+			uint64_t *bits = row(y);
+
+			std::fill(run.begin(), run.end(), (uint64_t)0);
+			std::copy(bits, bits + _stride, run.begin());
+			shiftUp(&run[0], &run[0], paddedWords, before);
+
+			unsigned int runLength = 1;
+
+			for (; runLength * 2 <= length; runLength *= 2)
+			{
+				shiftDown(&run[0], &shifted[0], paddedWords, runLength);
+
+				for (unsigned int k = 0; k < paddedWords; k++)
+				{
+					run[k] |= shifted[k];
+				}
+			}
+
+			shiftDown(&run[0], &shifted[0], paddedWords, length - runLength);
+
+			for (unsigned int k = 0; k < _stride; k++)
+			{
+				bits[k] = run[k] | shifted[k];
+			}
+		}
+
+		clearPadding();
+
+		// Along Y-axis with whole words as lanes, the cost does not depend on the window size
+		if (_height > 1)
+		{
+			morphology::filterLines<uint64_t, morphology::BitOrOp<uint64_t> >(&words[0], _height, _stride, _stride, before, after, forward, backward);
+		}
+	}
+
+	///
+	/// @brief Copies size and pixels of another mask (without its buffers), the memory of this mask is reused
+	///
+	void copyPixels(const BinaryMask &other)
+	{
+		_width = other._width;
+		_height = other._height;
+		_stride = other._stride;
+		words.assign(other.words.begin(), other.words.end());
+	}
+
+	///
+	/// @brief dst(x) = src(x + d) for a row of n words, pixels behind the row are zero
+	///
+	static inline void shiftDown(const uint64_t *src, uint64_t *dst, unsigned int n, unsigned int d)
+	{
+		const unsigned int wordShift = d / 64;
+		const unsigned int bitShift = d % 64;
+
+		for (unsigned int k = 0; k < n; k++)
+		{
+			const uint64_t low = (k + wordShift < n) ? src[k + wordShift] : 0;
+			const uint64_t high = (k + wordShift + 1 < n) ? src[k + wordShift + 1] : 0;
+
+			dst[k] = bitShift ? ((low >> bitShift) | (high << (64 - bitShift))) : low;
+		}
+	}
+
+	///
+	/// @brief dst(x) = src(x - d) for a row of n words (src and dst may be the same), pixels before the row are zero
+	///
+	static inline void shiftUp(const uint64_t *src, uint64_t *dst, unsigned int n, unsigned int d)
+	{
+		const unsigned int wordShift = d / 64;
+		const unsigned int bitShift = d % 64;
+
+		for (unsigned int k = n; k-- > 0;)
+		{
+			const uint64_t high = (k >= wordShift) ? src[k - wordShift] : 0;
+			const uint64_t low = (k >= wordShift + 1) ? src[k - wordShift - 1] : 0;
+
+			dst[k] = bitShift ? ((high << bitShift) | (low >> (64 - bitShift))) : high;
+		}
+	}
+
+	///
+	/// @brief Sets the bits behind the last pixel of every row to zero
+	///
+	void clearPadding()
+	{
+		if (_width % 64 == 0)
+		{
+			return;
+		}
+
+		const uint64_t valid = ((uint64_t)1 << (_width % 64)) - 1;
+
+		for (unsigned int y = 0; y < _height; y++)
+		{
+			row(y)[_stride - 1] &= valid;
+		}
+	}
+
+	unsigned int _width; ///< The width of the mask
+	unsigned int _height; ///< The height of the mask
+	unsigned int _stride; ///< The number of words per row
+	std::vector<uint64_t> words; ///< The pixels, row by row
+
+	std::vector<uint64_t> run, shifted; ///< Buffers for the rows of spread
+	cimg_library::CImg<uint64_t> forward, backward; ///< Buffers for the columns of spread
+};
+
+} // end namespace lime
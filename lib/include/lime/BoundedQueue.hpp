@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file BoundedQueue.hpp
+/// @brief Contains the BoundedQueue class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <deque>
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+namespace lime
+{
+
+///
+/// @class BoundedQueue
+///
+/// @version 0.3.0
+///
+/// @brief A thread-safe FIFO queue with a fixed capacity that connects two stages of a pipeline.
+///
+/// @details push blocks while the queue is full and pop blocks while it is empty, so a fast producer cannot run ahead of a slow consumer by
+/// more than the capacity. After close the remaining items can still be taken, then pop returns false.
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - The type of the items
+///
+template<typename T> class BoundedQueue
+{
+
+public:
+
+	///
+	/// @brief Creates an empty queue
+	/// @param _capacity The maximal number of items in the queue (at least 1)
+	///
+	BoundedQueue(unsigned int _capacity):capacity(_capacity > 0 ? _capacity : 1),closed(false){}
+
+	///
+	/// @brief Appends an item, waits while the queue is full.
+	/// @return false if the queue is closed (the item is not appended)
+	///
+	bool push(const T &item)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		notFull.wait(lock, [this]{ return closed || items.size() < capacity; });
+
+		if (closed)
+		{
+			return false;
+		}
+
+		items.push_back(item);
+		lock.unlock();
+		notEmpty.notify_one();
+
+		return true;
+	}
+
+	///
+	/// @brief Takes the oldest item, waits while the queue is empty.
+	/// @return false if the queue is closed and empty (item is not changed)
+	///
+	bool pop(T &item)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		notEmpty.wait(lock, [this]{ return closed || !items.empty(); });
+
+		if (items.empty())
+		{
+			return false;
+		}
+
+		item = items.front();
+		items.pop_front();
+		lock.unlock();
+		notFull.notify_one();
+
+		return true;
+	}
+
+	///
+	/// @brief Closes the queue: no more items can be pushed and waiting threads wake up.
+	///
+	void close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+		}
+
+		notFull.notify_all();
+		notEmpty.notify_all();
+	}
+
+private:
+
+	BoundedQueue(const BoundedQueue&); ///< Not copyable
+	BoundedQueue& operator=(const BoundedQueue&); ///< Not copyable
+
+	std::deque<T> items; ///< The items in the order they were pushed
+	const std::size_t capacity; ///< The maximal number of items
+	bool closed; ///< True if no more items can be pushed
+	std::mutex mutex; ///< Protects all members above
+	std::condition_variable notFull; ///< Signals that an item was taken or the queue was closed
+	std::condition_variable notEmpty; ///< Signals that an item was pushed or the queue was closed
+};
+
+} // end namespace lime
@@ -0,0 +1,394 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file Classifier.hpp
+/// @brief Contains the classifier policies of the colorimetric algorithms and the statically dispatched classification loop
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/Algorithm.hpp>
+#include <lime/simd.hpp>
+#include <CImg.h>
+#include <cmath>
+#include <stdint.h>
+
+namespace lime
+{
+
+///
+/// @brief Returns true if the SIMD kernels can be used for images of type T (only unsigned data types with 8 bits per channel).
+///
+template<typename T>
+inline bool simdSupported() { return sizeof(T) == 1 && !cimg_library::cimg::type<T>::is_float() && cimg_library::cimg::type<T>::min() == 0; }
+
+///
+/// @brief Transforms and classifies a row with a classifier policy. The policy is a template parameter, so transform and thresholds are inlined.
+/// @details A policy C provides static void transform(r, g, b, c1, c2, c3), bool operator()(c1, c2, c3) const and
+/// bool classifyVectorized(r, g, b, count, mask, approximate) const, which returns false if it has no SIMD kernel for the call.
+/// @param classifier The policy with the thresholds
+/// @param r The first channel of the row (R)
+/// @param g The second channel of the row (G)
+/// @param b The third channel of the row (B)
+/// @param count The number of pixels in the row
+/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+///
+template<class C, typename T>
+inline void classifyRowStatic(const C &classifier, const T *r, const T *g, const T *b, unsigned int count, bool *mask)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		double c1,c2,c3;
+
+		C::transform(r[i],g[i],b[i],c1,c2,c3);
+
+		mask[i] = classifier(c1,c2,c3);
+	}
+}
+
+///
+/// @struct YCbCrClassifier
+///
+/// @version 0.3.0
+///
+/// @brief Transformation to and fixed thresholds of the YCbCr color space (the policy of ColorimetricYCbCrAlgorithm1).
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - The data type of the input image
+///
+template<typename T> struct YCbCrClassifier
+{
+	YCbCrClassifier(Threshold _cb_lower = 77.0, Threshold _cb_higher = 127.0, Threshold _cr_lower = 133.0, Threshold _cr_higher = 173.0)
+		:cb_lower(_cb_lower),cb_higher(_cb_higher),cr_lower(_cr_lower),cr_higher(_cr_higher){}
+
+	///
+	/// @brief Transforms the image from the RGB color space to the YCbCr color space.
+	///
+	static cimg_library::CImg<double> transformImage(const cimg_library::CImg<T> &img) { return img.get_RGBtoYCbCr(); }
+
+	///
+	/// @brief Transforms a single pixel from the RGB color space to the YCbCr color space (same results as transformImage).
+	///
+	static inline void transform(const T &r, const T &g, const T &b, double &c1, double &c2, double &c3)
+	{
+		typedef typename cimg_library::CImg<T>::Tuchar Tuchar;
+		typedef typename cimg_library::CImg<Tuchar>::Tfloat Tfloat;
+
+		// Same computation (and precision) as CImg::get_RGBtoYCbCr, which works on a copy of type Tuchar (e.g. the result is truncated for unsigned char)
+		const Tfloat R = (Tfloat)(Tuchar)r;
+		const Tfloat G = (Tfloat)(Tuchar)g;
+		const Tfloat B = (Tfloat)(Tuchar)b;
+		const Tfloat Y = (66*R + 129*G + 25*B + 128)/256 + 16;
+		const Tfloat Cb = (-38*R - 74*G + 112*B + 128)/256 + 128;
+		const Tfloat Cr = (112*R - 94*G - 18*B + 128)/256 + 128;
+
+		c1 = (Tuchar)(Y<0?0:(Y>255?255:Y));
+		c2 = (Tuchar)(Cb<0?0:(Cb>255?255:Cb));
+		c3 = (Tuchar)(Cr<0?0:(Cr>255?255:Cr));
+	}
+
+	///
+	/// @brief Returns true if the YCbCr color (Y, Cb, Cr) is a skin color.
+	///
+	inline bool operator()(double /*c1*/, double c2, double c3) const
+	{
+		if (cb_lower <= c2 && c2 <= cb_higher)
+		{
+			return (cr_lower <= c3 && c3 <= cr_higher);
+		}
+
+		return false;
+	}
+
+	///
+	/// @brief Classifies a row of unsigned 8-bit pixels with the fixed-point SIMD kernel (exact, so approximate is not needed).
+	/// @return false if T is not supported
+	///
+	inline bool classifyVectorized(const T *r, const T *g, const T *b, unsigned int count, bool *mask, bool /*approximate*/) const
+	{
+		if (!simdSupported<T>())
+		{
+			return false;
+		}
+
+		// Cb and Cr are integers in [0,255], so the thresholds can be rounded towards the inside of the range
+		simd::classifyYCbCrRow((const unsigned char*)r, (const unsigned char*)g, (const unsigned char*)b, count, mask,
+			lowerBound(cb_lower), upperBound(cb_higher), lowerBound(cr_lower), upperBound(cr_higher));
+
+		return true;
+	}
+
+	///
+	/// @brief Smallest integer channel value that is not below the threshold (limited to [-1,256]).
+	///
+	static inline int16_t lowerBound(Threshold val) { return (int16_t)(val <= -1 ? -1 : (val > 256 ? 256 : std::ceil(val))); }
+
+	///
+	/// @brief Largest integer channel value that is not above the threshold (limited to [-1,256]).
+	///
+	static inline int16_t upperBound(Threshold val) { return (int16_t)(val < -1 ? -1 : (val >= 256 ? 256 : std::floor(val))); }
+
+	Threshold cb_lower;
+	Threshold cb_higher;
+	Threshold cr_lower;
+	Threshold cr_higher;
+};
+
+///
+/// @struct HSVClassifier
+///
+/// @version 0.3.0
+///
+/// @brief Transformation to and thresholds of the HSV color space (the policy of ColorimetricHSVAlgorithm1).
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - The data type of the input image
+///
+template<typename T> struct HSVClassifier
+{
+	HSVClassifier()
+		:s_lower_1(10),v_lower_1(40),v_multiplier_1(0.1),v_addend_1(110),v_multiplier_2(-0.4),v_addend_2(75),v_multiplier_3(0.08),v_addend_3(100),
+		v_multiplier_4(0.5),h_multiplier_1(0.5),h_addend_1(35){}
+
+	///
+	/// @brief Transforms the image from the RGB color space to the HSV color space.
+	///
+	static cimg_library::CImg<double> transformImage(const cimg_library::CImg<T> &img) { return img.get_RGBtoHSV(); }
+
+	///
+	/// @brief Transforms a single pixel from the RGB color space to the HSV color space (same results as transformImage).
+	///
+	static inline void transform(const T &r, const T &g, const T &b, double &c1, double &c2, double &c3)
+	{
+		typedef typename cimg_library::CImg<T>::Tfloat Tfloat;
+
+		// Same computation (and precision) as CImg::RGBtoHSV
+		const Tfloat R = (Tfloat)r;
+		const Tfloat G = (Tfloat)g;
+		const Tfloat B = (Tfloat)b;
+		const Tfloat nR = (R<0?0:(R>255?255:R))/255;
+		const Tfloat nG = (G<0?0:(G>255?255:G))/255;
+		const Tfloat nB = (B<0?0:(B>255?255:B))/255;
+		const Tfloat m = cimg_library::cimg::min(nR,nG,nB);
+		const Tfloat M = cimg_library::cimg::max(nR,nG,nB);
+
+		Tfloat H = 0, S = 0;
+
+		if (M != m)
+		{
+			const Tfloat f = (nR==m)?(nG-nB):((nG==m)?(nB-nR):(nR-nG));
+			const Tfloat i = (Tfloat)((nR==m)?3:((nG==m)?5:1));
+
+			H = (i-f/(M-m));
+
+			if (H >= 6)
+			{
+				H -= 6;
+			}
+
+			H *= 60;
+			S = (M-m)/M;
+		}
+
+		c1 = H;
+		c2 = S;
+		c3 = M;
+	}
+
+	///
+	/// @brief Returns true if the HSV color (H, S, V) is a skin color.
+	///
+	inline bool operator()(double c1, double c2, double c3) const
+	{
+		c2 *= 100;
+		c3 *= 100;
+
+		if (c2 < s_lower_1 || c3 < v_lower_1)
+		{
+			return false;
+		}
+
+		if (c2 > -c1 - v_multiplier_1*c3 + v_addend_1)
+		{
+			return false;
+		}
+
+		if (c1 > v_multiplier_2 * c3 + v_addend_2)
+		{
+			return false;
+		}
+
+		if (c1 >= 0)
+		{
+			return !(c2 > v_multiplier_3*(v_addend_3 - c3)*c1 + v_multiplier_4*c3);
+		}
+
+		return !(c2 > h_multiplier_1*c1 + h_addend_1);
+	}
+
+	///
+	/// @brief Classifies a row of unsigned 8-bit pixels with the single precision SIMD kernel (only if approximate results are allowed).
+	/// @return false if T is not supported or approximate is false
+	///
+	inline bool classifyVectorized(const T *r, const T *g, const T *b, unsigned int count, bool *mask, bool approximate) const
+	{
+		if (!approximate || !simdSupported<T>())
+		{
+			return false;
+		}
+
+		simd::HSVThresholds t = { (float)s_lower_1, (float)v_lower_1, (float)v_multiplier_1, (float)v_addend_1,
+			(float)v_multiplier_2, (float)v_addend_2, (float)v_multiplier_3, (float)v_addend_3,
+			(float)v_multiplier_4, (float)h_multiplier_1, (float)h_addend_1 };
+
+		simd::classifyHSVRow((const unsigned char*)r, (const unsigned char*)g, (const unsigned char*)b, count, mask, t);
+
+		return true;
+	}
+
+	Threshold s_lower_1;
+	Threshold v_lower_1;
+	Threshold v_multiplier_1;
+	Threshold v_addend_1;
+	Threshold v_multiplier_2;
+	Threshold v_addend_2;
+	Threshold v_multiplier_3;
+	Threshold v_addend_3;
+	Threshold v_multiplier_4;
+	Threshold h_multiplier_1;
+	Threshold h_addend_1;
+};
+
+///
+/// @struct HSIClassifier
+///
+/// @version 0.3.0
+///
+/// @brief Transformation to and thresholds of the HSI color space (the policy of ColorimetricHSIAlgorithm1).
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - The data type of the input image
+///
+template<typename T> struct HSIClassifier
+{
+	HSIClassifier()
+		:h_lower_1(1.0),h_higher_1(28.0),h_lower_2(332.0),h_higher_2(360.0),h_lower_3(309.0),h_higher_3(331.0),i_lower(0.4),s_lower(13.0/255.0),
+		s_higher_1(110.0/255.0),s_higher_2(75.0/255.0){}
+
+	///
+	/// @brief Transforms the image from the RGB color space to the HSI color space.
+	///
+	static cimg_library::CImg<double> transformImage(const cimg_library::CImg<T> &img) { return img.get_RGBtoHSI(); }
+
+	///
+	/// @brief Transforms a single pixel from the RGB color space to the HSI color space (same results as transformImage).
+	///
+	static inline void transform(const T &r, const T &g, const T &b, double &c1, double &c2, double &c3)
+	{
+		typedef typename cimg_library::CImg<T>::Tfloat Tfloat;
+
+		// Same computation (and precision) as CImg::RGBtoHSI
+		const Tfloat R = (Tfloat)r;
+		const Tfloat G = (Tfloat)g;
+		const Tfloat B = (Tfloat)b;
+		const Tfloat nR = (R<0?0:(R>255?255:R))/255;
+		const Tfloat nG = (G<0?0:(G>255?255:G))/255;
+		const Tfloat nB = (B<0?0:(B>255?255:B))/255;
+		const Tfloat m = cimg_library::cimg::min(nR,nG,nB);
+		const Tfloat theta = (Tfloat)(std::acos(0.5f*((nR-nG)+(nR-nB))/std::sqrt(std::pow(nR-nG,2)+(nR-nB)*(nG-nB)))*180/cimg_library::cimg::PI);
+		const Tfloat sum = nR + nG + nB;
+
+		Tfloat H = 0, S = 0;
+
+		if (theta > 0)
+		{
+			H = (nB<=nG)?theta:360-theta;
+		}
+
+		if (sum > 0)
+		{
+			S = 1 - 3/sum*m;
+		}
+
+		c1 = H;
+		c2 = S;
+		c3 = sum/3;
+	}
+
+	///
+	/// @brief Returns true if the HSI color (H, S, I) is a skin color.
+	///
+	inline bool operator()(double c1, double c2, double c3) const
+	{
+		if (c3 < i_lower)
+		{
+			return false;
+		}
+
+		if (s_lower && c2 < s_higher_2)
+		{
+			return (c1 > h_lower_3 && c1 < h_higher_3);
+		}
+
+		if (c2 > s_lower && c2 < s_higher_1)
+		{
+			return ((h_lower_1 < c1 && c1 < h_higher_1) || (h_lower_2 < c1 && c1 < h_higher_2));
+		}
+
+		return false;
+	}
+
+	///
+	/// @brief Classifies a row of unsigned 8-bit pixels with the single precision SIMD kernel (only if approximate results are allowed).
+	/// @return false if T is not supported or approximate is false
+	///
+	inline bool classifyVectorized(const T *r, const T *g, const T *b, unsigned int count, bool *mask, bool approximate) const
+	{
+		if (!approximate || !simdSupported<T>())
+		{
+			return false;
+		}
+
+		simd::HSIThresholds t = { (float)h_lower_1, (float)h_higher_1, (float)h_lower_2, (float)h_higher_2,
+			(float)h_lower_3, (float)h_higher_3, (float)i_lower, (float)s_lower, (float)s_higher_1, (float)s_higher_2 };
+
+		simd::classifyHSIRow((const unsigned char*)r, (const unsigned char*)g, (const unsigned char*)b, count, mask, t);
+
+		return true;
+	}
+
+	Threshold h_lower_1;
+	Threshold h_higher_1;
+	Threshold h_lower_2;
+	Threshold h_higher_2;
+	Threshold h_lower_3;
+	Threshold h_higher_3;
+	Threshold i_lower;
+	Threshold s_lower;
+	Threshold s_higher_1;
+	Threshold s_higher_2;
+};
+
+} // end namespace lime
@@ -30,6 +30,7 @@
 ///
 
 #include <lime/Algorithm.hpp>
+#include <lime/Classifier.hpp>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
@@ -48,6 +49,7 @@ namespace lime{
 	///
 	/// @author  Aleander Schoch
 	/// @date    Nov 13, 2012 - First creation and implementation
+	/// @date    Oct 16, 2026 - Transformation and thresholds shared with the HSIClassifier policy
 	/// @tparam T - Can be of any basic data type and should be the same as the one of the input image (e.g. double or char).
 	///
 	template<typename T> class ColorimetricHSIAlgorithm1: public Algorithm<T>{
@@ -61,21 +63,7 @@ namespace lime{
 			unsigned int _shrinkCount = 1, unsigned int _shrinkSize = 2, bool _applyFixedGrowShrink = false, unsigned int _fixedGrowShrinkCount = 1,
 			unsigned int _fixedGrowShrinkSize = 2, bool _applyGrowBeforeShrink = true, bool _applyRegionClearing = false)
 			:Algorithm<T>(_applyMedian,_medianSize, _applyGrow, _growCount, _growSize, _applyShrink, _shrinkCount, _shrinkSize, _applyFixedGrowShrink, _fixedGrowShrinkCount, _fixedGrowShrinkSize,
-			_applyGrowBeforeShrink, _applyRegionClearing)
-		{
-			// Initial values for all thresholds
-
-			this->h_lower_1 = 1.0;
-			this->h_higher_1 = 28.0;
-			this->h_lower_2 = 332.0;
-			this->h_higher_2 = 360.0;
-			this->h_lower_3 = 309.0;
-			this->h_higher_3 = 331.0;
-			this->i_lower = 0.4;
-			this->s_lower = 13.0/255.0;
-			this->s_higher_1 = 110.0/255.0;
-			this->s_higher_2 = 75.0/255.0;
-		}
+			_applyGrowBeforeShrink, _applyRegionClearing){}
 
 		///
 		/// @brief Basis destructor
@@ -84,26 +72,26 @@ namespace lime{
 
 		// Getter / Setter
 
-		virtual lime::Threshold H_Lower_1() const { return h_lower_1; }
-		virtual void H_Lower_1(lime::Threshold val) { h_lower_1 = val; }
-		virtual lime::Threshold H_Higher_1() const { return h_higher_1; }
-		virtual void H_Higher_1(lime::Threshold val) { h_higher_1 = val; }
-		virtual lime::Threshold H_Lower_2() const { return h_lower_2; }
-		virtual void H_Lower_2(lime::Threshold val) { h_lower_2 = val; }
-		virtual lime::Threshold H_Higher_2() const { return h_higher_2; }
-		virtual void H_Higher_2(lime::Threshold val) { h_higher_2 = val; }
-		virtual lime::Threshold H_Lower_3() const { return h_lower_3; }
-		virtual void H_Lower_3(lime::Threshold val) { h_lower_3 = val; }
-		virtual lime::Threshold H_Higher_3() const { return h_higher_3; }
-		virtual void H_Higher_3(lime::Threshold val) { h_higher_3 = val; }
-		virtual lime::Threshold I_Lower() const { return i_lower; }
-		virtual void I_Lower(lime::Threshold val) { i_lower = val; }
-		virtual lime::Threshold S_Lower() const { return s_lower; }
-		virtual void S_Lower(lime::Threshold val) { s_lower = val; }
-		virtual lime::Threshold S_Higher_1() const { return s_higher_1; }
-		virtual void S_Higher_1(lime::Threshold val) { s_higher_1 = val; }
-		virtual lime::Threshold S_Higher_2() const { return s_higher_2; }
-		virtual void S_Higher_2(lime::Threshold val) { s_higher_2 = val; }
+		virtual lime::Threshold H_Lower_1() const { return this->classifier.h_lower_1; }
+		virtual void H_Lower_1(lime::Threshold val) { this->classifier.h_lower_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Higher_1() const { return this->classifier.h_higher_1; }
+		virtual void H_Higher_1(lime::Threshold val) { this->classifier.h_higher_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Lower_2() const { return this->classifier.h_lower_2; }
+		virtual void H_Lower_2(lime::Threshold val) { this->classifier.h_lower_2 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Higher_2() const { return this->classifier.h_higher_2; }
+		virtual void H_Higher_2(lime::Threshold val) { this->classifier.h_higher_2 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Lower_3() const { return this->classifier.h_lower_3; }
+		virtual void H_Lower_3(lime::Threshold val) { this->classifier.h_lower_3 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Higher_3() const { return this->classifier.h_higher_3; }
+		virtual void H_Higher_3(lime::Threshold val) { this->classifier.h_higher_3 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold I_Lower() const { return this->classifier.i_lower; }
+		virtual void I_Lower(lime::Threshold val) { this->classifier.i_lower = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold S_Lower() const { return this->classifier.s_lower; }
+		virtual void S_Lower(lime::Threshold val) { this->classifier.s_lower = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold S_Higher_1() const { return this->classifier.s_higher_1; }
+		virtual void S_Higher_1(lime::Threshold val) { this->classifier.s_higher_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold S_Higher_2() const { return this->classifier.s_higher_2; }
+		virtual void S_Higher_2(lime::Threshold val) { this->classifier.s_higher_2 = val; this->invalidateLookupTable(); }
 
 	protected:
 
@@ -123,19 +111,21 @@ namespace lime{
 		///
 		virtual bool skinThresholds(double c1, double c2, double c3);
 
-		// Thresholds
-
-		Threshold h_lower_1;
-		Threshold h_higher_1;
-		Threshold h_lower_2;
-		Threshold h_higher_2;
-		Threshold h_lower_3;
-		Threshold h_higher_3;
-		Threshold i_lower;
-		Threshold s_lower;
-		Threshold s_higher_1;
-		Threshold s_higher_2;
-		
+		///
+		/// @brief Transforms the row into the HSI color space and classifies it in a single pass without an intermediate image.
+		///
+		virtual void classifyRow(const T *r, const T *g, const T *b, unsigned int count, bool *mask);
+
+		///
+		/// @brief Transforms a single pixel from the RGB color space to the HSI color space (same results as transformImage).
+		///
+		static inline void transformPixel(const T &r, const T &g, const T &b, double &c1, double &c2, double &c3);
+
+		///
+		/// @brief The transformation and the thresholds (the thresholds start with the defaults of the policy).
+		///
+		HSIClassifier<T> classifier;
+
 	};
 
 }
@@ -150,22 +140,32 @@ CImg<double>* lime::ColorimetricHSIAlgorithm1<T>::transformImage(const CImg<T> &
 }
 
 template<typename T>
-bool lime::ColorimetricHSIAlgorithm1<T>::skinThresholds( double c1, double c2, double c3 )
+void lime::ColorimetricHSIAlgorithm1<T>::classifyRow( const T *r, const T *g, const T *b, unsigned int count, bool *mask )
 {
-	if (c3 < this->i_lower)
+	// Single precision kernel without acos for 8-bit images (if activated)
+	if (this->classifier.classifyVectorized(r, g, b, count, mask, this->applyVectorization))
 	{
-		return false;
+		return;
 	}
 
-	if (this->s_lower && c2 < this->s_higher_2)
-	{
-		return (c1 > this->h_lower_3 && c1 < this->h_higher_3);
-	}
+	double c1,c2,c3;
 
-	if (c2 > this->s_lower && c2 < this->s_higher_1)
+	for (unsigned int i = 0; i < count; i++)
 	{
-		return ((this->h_lower_1 < c1 && c1 < this->h_higher_1) || (this->h_lower_2 < c1 && c1 < this->h_higher_2));
+		transformPixel(r[i],g[i],b[i],c1,c2,c3);
+
+		mask[i] = this->skinThresholds(c1,c2,c3);
 	}
+}
 
-	return false;
+template<typename T>
+inline void lime::ColorimetricHSIAlgorithm1<T>::transformPixel( const T &r, const T &g, const T &b, double &c1, double &c2, double &c3 )
+{
+	HSIClassifier<T>::transform(r,g,b,c1,c2,c3);
+}
+
+template<typename T>
+bool lime::ColorimetricHSIAlgorithm1<T>::skinThresholds( double c1, double c2, double c3 )
+{
+	return this->classifier(c1,c2,c3);
 }
\ No newline at end of file
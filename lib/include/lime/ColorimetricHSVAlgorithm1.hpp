@@ -30,6 +30,7 @@
 ///
 
 #include <lime/Algorithm.hpp>
+#include <lime/Classifier.hpp>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
@@ -48,6 +49,7 @@ namespace lime{
 	///
 	/// @author  Aleander Schoch
 	/// @date    Nov 14, 2012 - First creation and implementation
+	/// @date    Oct 16, 2026 - Transformation and thresholds shared with the HSVClassifier policy
 	///
 	template<typename T> class ColorimetricHSVAlgorithm1: public Algorithm<T>{
 
@@ -60,20 +62,7 @@ namespace lime{
 			unsigned int _shrinkCount = 1, unsigned int _shrinkSize = 2, bool _applyFixedGrowShrink = false, unsigned int _fixedGrowShrinkCount = 1,
 			unsigned int _fixedGrowShrinkSize = 2, bool _applyGrowBeforeShrink = true, bool _applyRegionClearing = false)
 			:Algorithm<T>(_applyMedian,_medianSize, _applyGrow, _growCount, _growSize, _applyShrink, _shrinkCount, _shrinkSize, _applyFixedGrowShrink, _fixedGrowShrinkCount, _fixedGrowShrinkSize,
-			_applyGrowBeforeShrink, _applyRegionClearing)
-		{
-			s_lower_1 = 10;
-			v_lower_1 = 40;
-			v_multiplier_1 = 0.1;
-			v_addend_1 = 110;
-			v_multiplier_2 = -0.4;
-			v_addend_2 = 75;
-			v_multiplier_3 = 0.08;
-			v_addend_3 = 100;
-			v_multiplier_4 = 0.5;
-			h_multiplier_1 = 0.5;
-			h_addend_1 = 35;
-		}
+			_applyGrowBeforeShrink, _applyRegionClearing){}
 
 		///
 		/// @brief Basis destructor
@@ -82,28 +71,28 @@ namespace lime{
 
 		// Getter / Setter
 
-		virtual lime::Threshold S_Lower_1() const { return this->s_lower_1; }
-		virtual void S_Lower_1(lime::Threshold val) { this->s_lower_1 = val; }
-		virtual lime::Threshold V_Lower_1() const { return this->v_lower_1; }
-		virtual void V_Lower_1(lime::Threshold val) { this->v_lower_1 = val; }
-		virtual lime::Threshold V_Multiplier_1() const { return this->v_multiplier_1; }
-		virtual void V_Multiplier_1(lime::Threshold val) { this->v_multiplier_1 = val; }
-		virtual lime::Threshold V_Addend_1() const { return this->v_addend_1; }
-		virtual void V_Addend_1(lime::Threshold val) { this->v_addend_1 = val; }
-		virtual lime::Threshold V_Multiplier_2() const { return this->v_multiplier_2; }
-		virtual void V_Multiplier_2(lime::Threshold val) { this->v_multiplier_2 = val; }
-		virtual lime::Threshold V_Addend_2() const { return this->v_addend_2; }
-		virtual void V_Addend_2(lime::Threshold val) { this->v_addend_2 = val; }
-		virtual lime::Threshold V_Multiplier_3() const { return this->v_multiplier_3; }
-		virtual void V_Multiplier_3(lime::Threshold val) { this->v_multiplier_3 = val; }
-		virtual lime::Threshold V_Addend_3() const { return this->v_addend_3; }
-		virtual void V_Addend_3(lime::Threshold val) { this->v_addend_3 = val; }
-		virtual lime::Threshold V_Multiplier_4() const { return this->v_multiplier_4; }
-		virtual void V_Multiplier_4(lime::Threshold val) { this->v_multiplier_4 = val; }
-		virtual lime::Threshold H_Multiplier_1() const { return this->h_multiplier_1; }
-		virtual void H_Multiplier_1(lime::Threshold val) { this->h_multiplier_1 = val; }
-		virtual lime::Threshold H_Addend_1() const { return this->h_addend_1; }
-		virtual void H_Addend_1(lime::Threshold val) { this->h_addend_1 = val; }
+		virtual lime::Threshold S_Lower_1() const { return this->classifier.s_lower_1; }
+		virtual void S_Lower_1(lime::Threshold val) { this->classifier.s_lower_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Lower_1() const { return this->classifier.v_lower_1; }
+		virtual void V_Lower_1(lime::Threshold val) { this->classifier.v_lower_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Multiplier_1() const { return this->classifier.v_multiplier_1; }
+		virtual void V_Multiplier_1(lime::Threshold val) { this->classifier.v_multiplier_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Addend_1() const { return this->classifier.v_addend_1; }
+		virtual void V_Addend_1(lime::Threshold val) { this->classifier.v_addend_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Multiplier_2() const { return this->classifier.v_multiplier_2; }
+		virtual void V_Multiplier_2(lime::Threshold val) { this->classifier.v_multiplier_2 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Addend_2() const { return this->classifier.v_addend_2; }
+		virtual void V_Addend_2(lime::Threshold val) { this->classifier.v_addend_2 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Multiplier_3() const { return this->classifier.v_multiplier_3; }
+		virtual void V_Multiplier_3(lime::Threshold val) { this->classifier.v_multiplier_3 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Addend_3() const { return this->classifier.v_addend_3; }
+		virtual void V_Addend_3(lime::Threshold val) { this->classifier.v_addend_3 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold V_Multiplier_4() const { return this->classifier.v_multiplier_4; }
+		virtual void V_Multiplier_4(lime::Threshold val) { this->classifier.v_multiplier_4 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Multiplier_1() const { return this->classifier.h_multiplier_1; }
+		virtual void H_Multiplier_1(lime::Threshold val) { this->classifier.h_multiplier_1 = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold H_Addend_1() const { return this->classifier.h_addend_1; }
+		virtual void H_Addend_1(lime::Threshold val) { this->classifier.h_addend_1 = val; this->invalidateLookupTable(); }
 
 	protected:
 
@@ -123,18 +112,21 @@ namespace lime{
 		///
 		virtual bool skinThresholds(double c1, double c2, double c3);
 
-		//Thresholds
-		Threshold s_lower_1;
-		Threshold v_lower_1;
-		Threshold v_multiplier_1;
-		Threshold v_addend_1;
-		Threshold v_multiplier_2;
-		Threshold v_addend_2;
-		Threshold v_multiplier_3;
-		Threshold v_addend_3;
-		Threshold v_multiplier_4;
-		Threshold h_multiplier_1;
-		Threshold h_addend_1;
+		///
+		/// @brief Transforms the row into the HSV color space and classifies it in a single pass without an intermediate image.
+		///
+		virtual void classifyRow(const T *r, const T *g, const T *b, unsigned int count, bool *mask);
+
+		///
+		/// @brief Transforms a single pixel from the RGB color space to the HSV color space (same results as transformImage).
+		///
+		static inline void transformPixel(const T &r, const T &g, const T &b, double &c1, double &c2, double &c3);
+
+		///
+		/// @brief The transformation and the thresholds (the thresholds start with the defaults of the policy).
+		///
+		HSVClassifier<T> classifier;
+
 	};
 
 }
@@ -149,45 +141,32 @@ CImg<double>* lime::ColorimetricHSVAlgorithm1<T>::transformImage(const CImg<T> &
 }
 
 template<typename T>
-bool lime::ColorimetricHSVAlgorithm1<T>::skinThresholds( double c1, double c2, double c3 )
+void lime::ColorimetricHSVAlgorithm1<T>::classifyRow( const T *r, const T *g, const T *b, unsigned int count, bool *mask )
 {
-	c2 *= 100;
-	c3 *= 100;
-
-	if (c2 < this->s_lower_1 || c3 < this->v_lower_1)
+	// Branch-free single precision kernel for 8-bit images (if activated)
+	if (this->classifier.classifyVectorized(r, g, b, count, mask, this->applyVectorization))
 	{
-		return false;
+		return;
 	}
 
+	double c1,c2,c3;
 
-	if (c2 > -c1 - this->v_multiplier_1*c3 + this->v_addend_1)
+	for (unsigned int i = 0; i < count; i++)
 	{
-		return false;
-	}
-
-
+		transformPixel(r[i],g[i],b[i],c1,c2,c3);
 
-	if (c1 > this->v_multiplier_2	* c3 + this->v_addend_2)
-	{
-		return false;
+		mask[i] = this->skinThresholds(c1,c2,c3);
 	}
+}
 
+template<typename T>
+inline void lime::ColorimetricHSVAlgorithm1<T>::transformPixel( const T &r, const T &g, const T &b, double &c1, double &c2, double &c3 )
+{
+	HSVClassifier<T>::transform(r,g,b,c1,c2,c3);
+}
 
-
-	if (c1 >= 0)
-	{
-		if (c2 > this->v_multiplier_3*(this->v_addend_3 - c3)*c1 + this->v_multiplier_4*c3)
-		{
-			return false;
-		}
-	} 
-	else
-	{
-		if (c2 > this->h_multiplier_1*c1 + this->h_addend_1)
-		{
-			return false;
-		}
-	}
-
-	return true;
+template<typename T>
+bool lime::ColorimetricHSVAlgorithm1<T>::skinThresholds( double c1, double c2, double c3 )
+{
+	return this->classifier(c1,c2,c3);
 }
\ No newline at end of file
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <lime/Algorithm.hpp>
+#include <lime/Classifier.hpp>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
@@ -48,6 +49,7 @@ namespace lime{
 	///
 	/// @author  Aleander Schoch
 	/// @date    Nov 14, 2012 - First creation and implementation
+	/// @date    Oct 16, 2026 - Transformation and thresholds shared with the YCbCrClassifier policy
 	///
 	template<typename T> class ColorimetricYCbCrAlgorithm1: public Algorithm<T>{
 
@@ -60,13 +62,7 @@ namespace lime{
 			unsigned int _shrinkCount = 1, unsigned int _shrinkSize = 2, bool _applyFixedGrowShrink = false, unsigned int _fixedGrowShrinkCount = 1,
 			unsigned int _fixedGrowShrinkSize = 2, bool _applyGrowBeforeShrink = true, bool _applyRegionClearing = false)
 			:Algorithm<T>(_applyMedian,_medianSize, _applyGrow, _growCount, _growSize, _applyShrink, _shrinkCount, _shrinkSize, _applyFixedGrowShrink, _fixedGrowShrinkCount, _fixedGrowShrinkSize,
-			_applyGrowBeforeShrink, _applyRegionClearing)
-		{
-			this->cb_lower = 77.0;
-			this->cb_higher = 127.0;
-			this->cr_lower = 133.0;
-			this->cr_higher = 173.0;
-		}
+			_applyGrowBeforeShrink, _applyRegionClearing){}
 
 		///
 		/// @brief Basis destructor
@@ -75,14 +71,14 @@ namespace lime{
 
 		// Getter / Setter
 
-		virtual lime::Threshold Cb_lower() const { return this->cb_lower; }
-		virtual void Cb_lower(lime::Threshold val) { this->cb_lower = val; }
-		virtual lime::Threshold Cb_higher() const { return this->cb_higher; }
-		virtual void Cb_higher(lime::Threshold val) { this->cb_higher = val; }
-		virtual lime::Threshold Cr_lower() const { return this->cr_lower; }
-		virtual void Cr_lower(lime::Threshold val) { this->cr_lower = val; }
-		virtual lime::Threshold Cr_higher() const { return this->cr_higher; }
-		virtual void Cr_higher(lime::Threshold val) { this->cr_higher = val; }
+		virtual lime::Threshold Cb_lower() const { return this->classifier.cb_lower; }
+		virtual void Cb_lower(lime::Threshold val) { this->classifier.cb_lower = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold Cb_higher() const { return this->classifier.cb_higher; }
+		virtual void Cb_higher(lime::Threshold val) { this->classifier.cb_higher = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold Cr_lower() const { return this->classifier.cr_lower; }
+		virtual void Cr_lower(lime::Threshold val) { this->classifier.cr_lower = val; this->invalidateLookupTable(); }
+		virtual lime::Threshold Cr_higher() const { return this->classifier.cr_higher; }
+		virtual void Cr_higher(lime::Threshold val) { this->classifier.cr_higher = val; this->invalidateLookupTable(); }
 
 	protected:
 
@@ -102,13 +98,20 @@ namespace lime{
 		///
 		virtual bool skinThresholds(double c1, double c2, double c3);
 
-		// Thresholds
+		///
+		/// @brief Transforms the row into the YCbCr color space and classifies it in a single pass without an intermediate image.
+		///
+		virtual void classifyRow(const T *r, const T *g, const T *b, unsigned int count, bool *mask);
 
-		Threshold cb_lower;
-		Threshold cb_higher;
-		Threshold cr_lower;
-		Threshold cr_higher;
+		///
+		/// @brief Transforms a single pixel from the RGB color space to the YCbCr color space (same results as transformImage).
+		///
+		static inline void transformPixel(const T &r, const T &g, const T &b, double &c1, double &c2, double &c3);
 
+		///
+		/// @brief The transformation and the thresholds (the thresholds start with the defaults of the policy).
+		///
+		YCbCrClassifier<T> classifier;
 
 	};
 
@@ -124,12 +127,32 @@ CImg<double>* lime::ColorimetricYCbCrAlgorithm1<T>::transformImage(const CImg<T>
 }
 
 template<typename T>
-bool lime::ColorimetricYCbCrAlgorithm1<T>::skinThresholds( double c1, double c2, double c3 )
+void lime::ColorimetricYCbCrAlgorithm1<T>::classifyRow( const T *r, const T *g, const T *b, unsigned int count, bool *mask )
 {
-	if(this->cb_lower <= c2 <= this->cb_higher)
+	// Unsigned 8-bit images are classified by the vectorized fixed-point kernel, which gives the same results as transformPixel and skinThresholds
+	if (this->classifier.classifyVectorized(r, g, b, count, mask, this->applyVectorization))
+	{
+		return;
+	}
+
+	double c1,c2,c3;
+
+	for (unsigned int i = 0; i < count; i++)
 	{
-		return (this->cr_lower <= c3 && c3 <= this->cr_higher);
+		transformPixel(r[i],g[i],b[i],c1,c2,c3);
+
+		mask[i] = this->skinThresholds(c1,c2,c3);
 	}
+}
+
+template<typename T>
+inline void lime::ColorimetricYCbCrAlgorithm1<T>::transformPixel( const T &r, const T &g, const T &b, double &c1, double &c2, double &c3 )
+{
+	YCbCrClassifier<T>::transform(r,g,b,c1,c2,c3);
+}
 
-	return false;
+template<typename T>
+bool lime::ColorimetricYCbCrAlgorithm1<T>::skinThresholds( double c1, double c2, double c3 )
+{
+	return this->classifier(c1,c2,c3);
 }
\ No newline at end of file
@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file Contour.hpp
+/// @brief Contains the border following of Suzuki and Abe, which extracts the ordered boundary seeds of the regions of a bit mask
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/util.hpp>
+#include <CImg.h>
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+
+namespace lime
+{
+
+///
+/// @namespace contour
+/// @brief Border following in linear time (S. Suzuki, K. Abe: "Topological structural analysis of digitized binary images by border following").
+///
+/// @details A raster scan finds the first pixel of every outer border and every hole border of the 8-connected regions of a value, and each border
+/// is followed pixel by pixel from there. The labels written while following a border make sure that every border is followed exactly once, so
+/// the whole mask is processed in time linear in its size. The pixels of a border are delivered in the order in which they are followed.
+///
+namespace contour
+{
+
+///
+/// @struct Contour
+///
+/// @version 0.3.0
+///
+/// @brief A border of a region. Its seeds are stored one after the other in the seed buffer.
+///
+/// @date Oct 16, 2026 - First creation
+///
+struct Contour
+{
+public:
+
+	Contour():first(0),count(0),region(0),hole(false){}
+	Contour(std::size_t _first, std::size_t _count, unsigned int _region, bool _hole):first(_first),count(_count),region(_region),hole(_hole){}
+
+	std::size_t first;		///< The index of the first seed of the border in the seed buffer
+	std::size_t count;		///< The number of seeds of the border
+	unsigned int region;	///< The number of the region in raster order (the outer border and the hole borders of a region have the same number)
+	bool hole;				///< True if the border separates the region from a hole, false if it is the outer border of the region
+};
+
+///
+/// @brief The buffers of traceContours, kept between the calls so they do not allocate memory for masks of the same size
+///
+struct Buffers
+{
+	cimg_library::CImg<int> labels; ///< The mask with a frame of 2 pixels, 0 = other value, 1 = value, +-n = pixel of border n
+	std::vector<unsigned int> borders; ///< The region (shifted left by 1) and the hole flag (bit 0) of every border number
+
+	///
+	/// @brief Returns the number of bytes held by the buffers
+	///
+	std::size_t footprint() const { return labels.size() * sizeof(int) + borders.capacity() * sizeof(unsigned int); }
+};
+
+///
+/// @brief Follows the borders of all 8-connected regions of a value in a bit mask and writes their pixels as ordered seeds.
+/// @details The pixels outside of the mask count as non-skin. The seeds of skin regions (value = true) are the skin pixels next to non-skin or the
+/// image border, the seeds of non-skin regions (value = false) the non-skin pixels next to skin, so the hole borders of the non-skin region that
+/// touches the image border run around the skin regions (next to means one of the 4 direct neighbors). Where a border runs back over a one pixel wide
+/// part, the pixels are only delivered the first time, so the order can jump there. A pixel that also lies on another border can appear twice.
+/// @param mask The bit mask
+/// @param value The value of the regions (true = skin, false = non-skin)
+/// @param singleRegion Only the first border in raster order is extracted (the outer border of the first region, or for non-skin the border around the first skin region)
+/// @param stride Only every stride-th pixel of a border is a seed (the first pixel always is)
+/// @param seeds Receives the seeds of all borders, each border in the order it is followed (its memory is reused)
+/// @param contours Receives the borders (its memory is reused)
+/// @param buffers The temporary buffers
+///
+inline void traceContours(const cimg_library::CImg<bool> &mask, bool value, bool singleRegion, unsigned int stride, std::vector<BinarySeed> &seeds,
+	std::vector<Contour> &contours, Buffers &buffers)
+{
+	const int width = mask.width();
+	const int height = mask.height();
+
+	seeds.clear();
+	contours.clear();
+	stride = std::max(1u, stride);
+
+	// Outside of the mask is non-skin: the inner frame belongs to the non-skin regions, the outer frame stays 0, so every border can be followed
+	// without bound checks
+	const int paddedWidth = width + 4;
+	const int paddedHeight = height + 4;
+	const int frame = value ? 0 : 1;
+
+	cimg_library::CImg<int> &labels = buffers.labels;
+	labels.assign(paddedWidth, paddedHeight, 1, 1);
+	labels.fill(0);
+
+	for (int y = 1; y < paddedHeight - 1; y++)
+	{
+		int *row = labels.data(0,y,0,0);
+
+		if (y == 1 || y == paddedHeight - 2)
+		{
+			std::fill(row + 1, row + paddedWidth - 1, frame);
+			continue;
+		}
+
+		const bool *src = mask.data(0,y - 2,0,0);
+		row[1] = frame;
+		row[paddedWidth - 2] = frame;
+
+		for (int x = 0; x < width; x++)
+		{
+			row[x + 2] = (src[x] == value) ? 1 : 0;
+		}
+	}
+
+	// The 8 neighbors in clockwise order, starting with the right neighbor
+	const int offsets[8] = { 1, paddedWidth + 1, paddedWidth, paddedWidth - 1, -1, -paddedWidth - 1, -paddedWidth, -paddedWidth + 1 };
+
+	int *f = labels.data();
+
+	// Border number 1 is the frame around the padded mask (a hole border without region)
+	std::vector<unsigned int> &borders = buffers.borders;
+	borders.assign(1, 1u);
+
+	int nbd = 1;
+	unsigned int regionCount = 0;
+
+	for (int y = 1; y < paddedHeight - 1; y++)
+	{
+		int lnbd = 1;
+
+		for (int x = 1; x < paddedWidth - 1; x++)
+		{
+			const int start = y * paddedWidth + x;
+			const int fv = f[start];
+
+			if (fv == 0)
+			{
+				continue;
+			}
+
+			bool hole;
+
+			if (fv == 1 && f[start - 1] == 0)
+			{
+				hole = false;
+			}
+			else if (fv >= 1 && f[start + 1] == 0)
+			{
+				hole = true;
+
+				if (fv > 1)
+				{
+					lnbd = fv;
+				}
+			}
+			else
+			{
+				if (fv != 1)
+				{
+					lnbd = std::abs(fv);
+				}
+
+				continue;
+			}
+
+			// A new outer border starts a new region, a hole border belongs to the region of the last border that was passed
+			nbd++;
+			const unsigned int region = hole ? (borders[lnbd - 1] >> 1) : regionCount++;
+			borders.push_back((region << 1) | (hole ? 1u : 0u));
+
+			const std::size_t first = seeds.size();
+			unsigned int index = 0;
+
+			// Adds a pixel of the border (only pixels inside of the mask, only every stride-th one and each at most once)
+			auto addSeed = [&](int p)
+			{
+				const int px = p % paddedWidth - 2;
+				const int py = p / paddedWidth - 2;
+
+				if (px < 0 || py < 0 || px >= width || py >= height || std::abs(f[p]) == nbd)
+				{
+					return;
+				}
+
+				if (index++ % stride == 0)
+				{
+					seeds.push_back(BinarySeed((unsigned int)px, (unsigned int)py, value));
+				}
+			};
+
+			// Searches clockwise around the first pixel for a neighbor of the region, starting at the 0-pixel on the left (outer) or right (hole) side
+			const int from = hole ? 0 : 4;
+			int direction = -1;
+
+			for (int k = 0; k < 8; k++)
+			{
+				if (f[start + offsets[(from + k) & 7]] != 0)
+				{
+					direction = (from + k) & 7;
+					break;
+				}
+			}
+
+			if (direction < 0)
+			{
+				// A single pixel
+				addSeed(start);
+				f[start] = -nbd;
+			}
+			else
+			{
+				const int second = start + offsets[direction];
+				int current = start;
+
+				// The direction from the current pixel back to the previous one
+				int back = direction;
+
+				while (true)
+				{
+					// Searches counterclockwise around the current pixel for the next pixel of the border, starting after the previous one
+					bool rightExamined = false;
+					int next = current;
+					int d = back;
+
+					for (int k = 1; k <= 8; k++)
+					{
+						d = (back - k) & 7;
+
+						if (f[current + offsets[d]] != 0)
+						{
+							next = current + offsets[d];
+							break;
+						}
+
+						if (d == 0)
+						{
+							rightExamined = true;
+						}
+					}
+
+					addSeed(current);
+
+					// A pixel with a 0-pixel on its right is marked negative, so the raster scan does not start another border there
+					if (rightExamined)
+					{
+						f[current] = -nbd;
+					}
+					else if (f[current] == 1)
+					{
+						f[current] = nbd;
+					}
+
+					if (next == start && current == second)
+					{
+						break;
+					}
+
+					back = (d + 4) & 7;
+					current = next;
+				}
+			}
+
+			if (seeds.size() > first)
+			{
+				contours.push_back(Contour(first, seeds.size() - first, region, hole));
+
+				if (singleRegion)
+				{
+					return;
+				}
+			}
+
+			if (f[start] != 1)
+			{
+				lnbd = std::abs(f[start]);
+			}
+		}
+	}
+}
+
+} // end namespace contour
+
+} // end namespace lime
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file DistanceTransform.hpp
+/// @brief Contains the exact Euclidean distance transform of Meijster et al.
+/// @date Oct 16, 2026 - First creation
+/// @date Oct 16, 2026 - Column and row pass distributed over a thread pool
+/// @package lime
+///
+
+#include <lime/BinaryMask.hpp>
+#include <lime/ThreadPool.hpp>
+#include <CImg.h>
+#include <vector>
+#include <algorithm>
+
+namespace lime
+{
+
+///
+/// @namespace distance
+/// @brief Exact squared Euclidean distance transform in linear time (A. Meijster, J. Roerdink, W. Hesselink: "A general algorithm for computing distance transforms in linear time").
+///
+/// @details The transform is separable: the column pass computes the distance to the nearest feature pixel in the same column, the row pass
+/// combines these distances of all columns with the lower envelope of parabolas. Both passes only use integers, so the result is exact.
+/// Each pass works on independent ranges (columns resp. rows), so the ranges can be processed in parallel.
+///
+namespace distance
+{
+
+///
+/// @brief The buffers of squaredDistanceTransform, kept between the calls so they do not allocate memory for masks of the same size
+///
+struct Buffers
+{
+	cimg_library::CImg<int> columnDistances; ///< The distances of the column pass
+	std::vector<int> envelopes; ///< The lower envelope of the parabolas of every row task (2 * width values per task)
+
+	///
+	/// @brief Returns the number of bytes held by the buffers
+	///
+	std::size_t footprint() const { return columnDistances.size() * sizeof(int) + envelopes.capacity() * sizeof(int); }
+};
+
+///
+/// @brief Returns the value that marks columns without any feature pixel (bigger than every real distance)
+///
+inline int infinity(const BinaryMask &features) { return (int)(features.width() + features.height()); }
+
+///
+/// @brief Computes for the columns [x0,x1) the distance of every pixel to the nearest feature pixel in the same column.
+/// @param features The feature pixels (distance 0)
+/// @param columnDistances Receives the distances (has to have the size of the features already), infinity() if the column has no feature pixel
+/// @param x0 The first column
+/// @param x1 The column after the last column
+///
+inline void columnPass(const BinaryMask &features, cimg_library::CImg<int> &columnDistances, unsigned int x0, unsigned int x1)
+{
+	const unsigned int height = features.height();
+	const int inf = infinity(features);
+
+	if (height == 0)
+	{
+		return;
+	}
+
+	// Both scans run row by row over all columns of the range, so the memory is read sequentially
+	for (unsigned int y = 0; y < height; y++)
+	{
+		const uint64_t *bits = features.row(y);
+		int *dst = columnDistances.data(0,y,0,0);
+		const int *prev = (y > 0) ? columnDistances.data(0,y-1,0,0) : 0;
+
+		for (unsigned int x = x0; x < x1; x++)
+		{
+			if ((bits[x / 64] >> (x % 64)) & 1)
+			{
+				dst[x] = 0;
+			}
+			else
+			{
+				dst[x] = (prev && prev[x] < inf) ? prev[x] + 1 : inf;
+			}
+		}
+	}
+
+	for (unsigned int y = height - 1; y-- > 0;)
+	{
+		int *dst = columnDistances.data(0,y,0,0);
+		const int *next = columnDistances.data(0,y+1,0,0);
+
+		for (unsigned int x = x0; x < x1; x++)
+		{
+			if (next[x] + 1 < dst[x])
+			{
+				dst[x] = next[x] + 1;
+			}
+		}
+	}
+}
+
+///
+/// @brief Computes for the rows [y0,y1) the squared distance of every pixel to the nearest feature pixel out of the column distances.
+/// @param columnDistances The result of columnPass for all columns
+/// @param squaredDistances Receives the squared distances (has to have the size of the column distances already)
+/// @param y0 The first row
+/// @param y1 The row after the last row
+/// @param envelope Room for the lower envelope of a row (2 * width values)
+///
+inline void rowPass(const cimg_library::CImg<int> &columnDistances, cimg_library::CImg<int> &squaredDistances, unsigned int y0, unsigned int y1, int *envelope)
+{
+	const int width = columnDistances.width();
+
+	if (width == 0)
+	{
+		return;
+	}
+
+	// s holds the columns whose parabolas form the lower envelope, t the first pixel where each of them is the minimum
+	int *s = envelope;
+	int *t = envelope + width;
+
+	for (unsigned int y = y0; y < y1; y++)
+	{
+		const int *g = columnDistances.data(0,y,0,0);
+		int *dst = squaredDistances.data(0,y,0,0);
+
+		// Squared distance of pixel x to the nearest feature pixel in column i
+		auto f = [g](long long x, long long i) -> long long { return (x - i) * (x - i) + (long long)g[i] * g[i]; };
+
+		int q = 0;
+		s[0] = 0;
+		t[0] = 0;
+
+		for (int u = 1; u < width; u++)
+		{
+			while (q >= 0 && f(t[q], s[q]) > f(t[q], u))
+			{
+				q--;
+			}
+
+			if (q < 0)
+			{
+				q = 0;
+				s[0] = u;
+			}
+			else
+			{
+				// First pixel where the parabola of column u is not above the one of column s[q]
+				const long long i = s[q];
+				const long long sep = ((long long)u * u - i * i + (long long)g[u] * g[u] - (long long)g[i] * g[i]) / (2 * (u - i));
+				const long long w = 1 + sep;
+
+				if (w < width)
+				{
+					q++;
+					s[q] = u;
+					t[q] = (int)w;
+				}
+			}
+		}
+
+		for (int u = width - 1; u >= 0; u--)
+		{
+			dst[u] = (int)f(u, s[q]);
+
+			if (u == t[q])
+			{
+				q--;
+			}
+		}
+	}
+}
+
+///
+/// @brief Computes the squared Euclidean distance of every pixel to the nearest feature pixel.
+/// @details With a thread pool the column pass is split into ranges of columns and the row pass into ranges of rows. Every distance is
+/// computed by exactly one task in the same way as in the serial case, so the result does not depend on the number of threads.
+/// @param features The feature pixels (at least one has to be set)
+/// @param squaredDistances Receives the squared distances (its memory is reused if it already has the right size)
+/// @param pool The thread pool that runs the passes (0 = serial)
+/// @param buffers The column distances and the envelopes (0 = temporary buffers)
+///
+inline void squaredDistanceTransform(const BinaryMask &features, cimg_library::CImg<int> &squaredDistances, ThreadPool *pool = 0, Buffers *buffers = 0)
+{
+	const unsigned int width = features.width();
+	const unsigned int height = features.height();
+
+	Buffers localBuffers;
+	Buffers &taskBuffers = buffers ? *buffers : localBuffers;
+	cimg_library::CImg<int> &columnDistances = taskBuffers.columnDistances;
+	columnDistances.assign(width, height, 1, 1);
+	squaredDistances.assign(width, height, 1, 1);
+
+	const unsigned int taskCount = pool ? std::max(1u, std::min(pool->size(), height)) : 1;
+
+	// resize keeps the memory if the envelopes do not grow
+	taskBuffers.envelopes.resize((std::size_t)taskCount * 2 * width);
+
+	if (taskCount == 1)
+	{
+		columnPass(features, columnDistances, 0, width);
+		rowPass(columnDistances, squaredDistances, 0, height, taskBuffers.envelopes.data());
+		return;
+	}
+
+	// The column ranges start at multiples of 64, so no two tasks write into the same cache line
+	auto columnTask = [&](unsigned int task)
+	{
+		const unsigned int x0 = std::min(width, (unsigned int)((unsigned long long)task * width / taskCount) / 64 * 64);
+		const unsigned int x1 = (task + 1 == taskCount) ? width : std::min(width, (unsigned int)((unsigned long long)(task + 1) * width / taskCount) / 64 * 64);
+
+		columnPass(features, columnDistances, x0, x1);
+	};
+
+	auto rowTask = [&](unsigned int task)
+	{
+		rowPass(columnDistances, squaredDistances, (unsigned int)((unsigned long long)task * height / taskCount), (unsigned int)((unsigned long long)(task + 1) * height / taskCount),
+			taskBuffers.envelopes.data() + (std::size_t)task * 2 * width);
+	};
+
+	// The reference wrappers keep std::function from copying the lambdas to the heap
+	pool->parallelFor(taskCount, std::ref(columnTask));
+	pool->parallelFor(taskCount, std::ref(rowTask));
+}
+
+} // end namespace distance
+
+} // end namespace lime
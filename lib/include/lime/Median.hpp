@@ -0,0 +1,378 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file Median.hpp
+/// @brief Contains the constant time median filter of Perreault and Hebert for 8-bit images
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/ThreadPool.hpp>
+#include <CImg.h>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+namespace lime
+{
+
+///
+/// @namespace median
+/// @brief Median filter whose cost per pixel does not depend on the kernel size (S. Perreault, P. Hebert: "Median Filtering in Constant Time").
+///
+/// @details Every column keeps a histogram of the pixels of the kernel rows. Moving down one row adds one pixel to and removes one pixel from
+/// each column histogram, moving right one pixel adds one column histogram to and removes one from the kernel histogram. The median is found
+/// with a coarse histogram of 16 bins and a single fine bin of 16 values. The image is processed in strips of columns, so the column histograms
+/// stay in the cache, and the strips are independent tasks for a thread pool.
+///
+/// The result is identical to CImg::get_blur_median: the window [x - n/2, x + n/2 - 1 + n%2] is clipped at the image border and the median of an
+/// even number of values is the (truncated) mean of the two middle values, except for 5x5 kernels, where CImg replicates the border pixels instead.
+/// A sorting network is faster than the histograms for 3x3 kernels, so this size uses the network of CImg (for all data types). 1D and 3D images
+/// are still filtered by CImg.
+///
+namespace median
+{
+
+///
+/// @brief Number of columns of a strip
+///
+const unsigned int stripWidth = 128;
+
+///
+/// @brief Returns true if the image is filtered with histograms, false if it is passed on to CImg.
+///
+template<typename T>
+inline bool isConstantTime(const cimg_library::CImg<T> &img, unsigned int n)
+{
+	return sizeof(T) == 1 && !cimg_library::cimg::type<T>::is_float() && cimg_library::cimg::type<T>::min() == 0
+		&& img.depth() == 1 && img.height() > 1 && n > 1 && n != 3 && n < 65536;
+}
+
+///
+/// @brief The column histograms of a strip. Can be kept between calls, so the filter does not allocate memory for images of the same size.
+///
+struct Buffers
+{
+	std::vector<uint16_t> columnFine; ///< 256 bins per column
+	std::vector<uint16_t> columnCoarse; ///< 16 bins per column
+
+	///
+	/// @brief Returns the number of bytes held by the buffers
+	///
+	inline std::size_t footprint() const { return (columnFine.capacity() + columnCoarse.capacity()) * sizeof(uint16_t); }
+};
+
+///
+/// @brief Returns the k-th smallest value (starting with 0) of the kernel histogram.
+///
+inline unsigned int kthSmallest(const uint32_t *fine, const uint32_t *coarse, uint32_t k)
+{
+	unsigned int c = 0;
+
+	while (coarse[c] <= k)
+	{
+		k -= coarse[c];
+		c++;
+	}
+
+	unsigned int v = c * 16;
+
+	while (fine[v] <= k)
+	{
+		k -= fine[v];
+		v++;
+	}
+
+	return v;
+}
+
+///
+/// @brief Filters the columns [x0,x1) of a single channel.
+/// @param src The channel of the input image
+/// @param dst The channel of the result
+/// @param width The width of the channel
+/// @param height The height of the channel
+/// @param x0 The first column of the strip
+/// @param x1 The column after the last column of the strip
+/// @param hl The number of pixels of the kernel before the center (n/2)
+/// @param hr The number of pixels of the kernel after the center (n/2 - 1 + n%2)
+/// @param replicate True if the pixels outside of the image are replaced by the nearest border pixel, false if the window is clipped
+/// @param buffers Holds the column histograms
+///
+inline void filterStrip(const unsigned char *src, unsigned char *dst, int width, int height, int x0, int x1, int hl, int hr, bool replicate, Buffers &buffers)
+{
+	// Columns that contribute to the strip
+	const int cx0 = std::max(0, x0 - hl);
+	const int cx1 = std::min(width, x1 + hr);
+	const int columns = cx1 - cx0;
+
+	std::vector<uint16_t> &columnFine = buffers.columnFine;
+	std::vector<uint16_t> &columnCoarse = buffers.columnCoarse;
+	columnFine.assign((std::size_t)columns * 256, 0);
+	columnCoarse.assign((std::size_t)columns * 16, 0);
+
+	uint32_t fine[256], coarse[16];
+
+	auto updateColumns = [&](int y, int delta)
+	{
+		const unsigned char *row = src + (std::size_t)y * width;
+
+		for (int x = cx0; x < cx1; x++)
+		{
+			const unsigned char v = row[x];
+			columnFine[(std::size_t)(x - cx0) * 256 + v] += (uint16_t)delta;
+			columnCoarse[(std::size_t)(x - cx0) * 16 + (v >> 4)] += (uint16_t)delta;
+		}
+	};
+
+	// Plain loops over all bins, the compiler vectorizes them
+	auto addColumn = [&](int x)
+	{
+		const uint16_t *f = &columnFine[(std::size_t)(x - cx0) * 256];
+		const uint16_t *c = &columnCoarse[(std::size_t)(x - cx0) * 16];
+
+		for (int v = 0; v < 256; v++)
+		{
+			fine[v] += f[v];
+		}
+
+		for (int v = 0; v < 16; v++)
+		{
+			coarse[v] += c[v];
+		}
+	};
+
+	auto removeColumn = [&](int x)
+	{
+		const uint16_t *f = &columnFine[(std::size_t)(x - cx0) * 256];
+		const uint16_t *c = &columnCoarse[(std::size_t)(x - cx0) * 16];
+
+		for (int v = 0; v < 256; v++)
+		{
+			fine[v] -= f[v];
+		}
+
+		for (int v = 0; v < 16; v++)
+		{
+			coarse[v] -= c[v];
+		}
+	};
+
+	// Replicated borders count the border pixel once for every position outside of the image, clipped windows skip these positions
+	auto clampY = [height](int y) { return std::min(height - 1, std::max(0, y)); };
+	auto clampX = [width](int x) { return std::min(width - 1, std::max(0, x)); };
+
+	// The column histograms of the first row cover the rows [-hl,hr]
+	for (int y = -hl; y <= hr; y++)
+	{
+		if (replicate || (y >= 0 && y < height))
+		{
+			updateColumns(clampY(y), 1);
+		}
+	}
+
+	for (int y = 0; y < height; y++)
+	{
+		if (y > 0)
+		{
+			if (replicate || y + hr < height)
+			{
+				updateColumns(clampY(y + hr), 1);
+			}
+
+			if (replicate || y - hl - 1 >= 0)
+			{
+				updateColumns(clampY(y - hl - 1), -1);
+			}
+		}
+
+		const uint32_t rows = replicate ? (uint32_t)(hl + hr + 1) : (uint32_t)(std::min(height - 1, y + hr) - std::max(0, y - hl) + 1);
+
+		std::fill(fine, fine + 256, 0);
+		std::fill(coarse, coarse + 16, 0);
+
+		for (int x = x0 - hl; x <= x0 + hr; x++)
+		{
+			if (replicate || (x >= 0 && x < width))
+			{
+				addColumn(clampX(x));
+			}
+		}
+
+		unsigned char *out = dst + (std::size_t)y * width;
+
+		for (int x = x0; x < x1; x++)
+		{
+			if (x > x0)
+			{
+				if (replicate || x + hr < width)
+				{
+					addColumn(clampX(x + hr));
+				}
+
+				if (replicate || x - hl - 1 >= 0)
+				{
+					removeColumn(clampX(x - hl - 1));
+				}
+			}
+
+			const uint32_t count = rows * (replicate ? (uint32_t)(hl + hr + 1) : (uint32_t)(std::min(width - 1, x + hr) - std::max(0, x - hl) + 1));
+			const unsigned int upper = kthSmallest(fine, coarse, count / 2);
+
+			if (count % 2)
+			{
+				out[x] = (unsigned char)upper;
+			}
+			else
+			{
+				out[x] = (unsigned char)((upper + kthSmallest(fine, coarse, count / 2 - 1)) / 2);
+			}
+		}
+	}
+}
+
+///
+/// @brief Filters the rows [y0,y1) of a single channel with a 3x3 kernel (the border pixels are replicated).
+/// @details Uses the sorting network of CImg::get_blur_median, so the result is the same for every data type.
+///
+template<typename T>
+void filter3x3(const T *src, T *dst, int width, int height, int y0, int y1)
+{
+#define _lime_median_sort(a,b) if ((a) > (b)) std::swap(a,b)
+
+	for (int y = y0; y < y1; y++)
+	{
+		const T *rowP = src + (std::size_t)std::max(0, y - 1) * width;
+		const T *rowC = src + (std::size_t)y * width;
+		const T *rowN = src + (std::size_t)std::min(height - 1, y + 1) * width;
+		T *out = dst + (std::size_t)y * width;
+
+		for (int x = 0; x < width; x++)
+		{
+			const int px = std::max(0, x - 1), nx = std::min(width - 1, x + 1);
+
+			// The names follow CImg: the first letter is the column, the second one the row (p = previous, c = current, n = next)
+			T Jpp = rowP[px], Jcp = rowP[x], Jnp = rowP[nx];
+			T Jpc = rowC[px], Jcc = rowC[x], Jnc = rowC[nx];
+			T Jpn = rowN[px], Jcn = rowN[x], Jnn = rowN[nx];
+
+			_lime_median_sort(Jcp, Jnp); _lime_median_sort(Jcc, Jnc); _lime_median_sort(Jcn, Jnn);
+			_lime_median_sort(Jpp, Jcp); _lime_median_sort(Jpc, Jcc); _lime_median_sort(Jpn, Jcn);
+			_lime_median_sort(Jcp, Jnp); _lime_median_sort(Jcc, Jnc); _lime_median_sort(Jcn, Jnn);
+			_lime_median_sort(Jpp, Jpc); _lime_median_sort(Jnc, Jnn); _lime_median_sort(Jcc, Jcn);
+			_lime_median_sort(Jpc, Jpn); _lime_median_sort(Jcp, Jcc); _lime_median_sort(Jnp, Jnc);
+			_lime_median_sort(Jcc, Jcn); _lime_median_sort(Jcc, Jnp); _lime_median_sort(Jpn, Jcc);
+			_lime_median_sort(Jcc, Jnp);
+
+			out[x] = Jcc;
+		}
+	}
+
+#undef _lime_median_sort
+}
+
+///
+/// @brief Median filters the image into res (same result as CImg::get_blur_median(n)).
+/// @param img The image
+/// @param n The size of the kernel
+/// @param res Receives the filtered image (its memory is reused if it already has the right size)
+/// @param pool The thread pool that filters the strips of all channels (0 = serial)
+/// @param buffers The column histograms for the serial case (0 = temporary buffers)
+///
+template<typename T>
+void blurMedian(const cimg_library::CImg<T> &img, unsigned int n, cimg_library::CImg<T> &res, ThreadPool *pool = 0, Buffers *buffers = 0)
+{
+	if (n == 3 && img.depth() == 1 && img.height() > 1)
+	{
+		res.assign(img.width(), img.height(), 1, img.spectrum());
+
+		cimg_forC(img,c)
+		{
+			filter3x3(img.data(0,0,0,c), res.data(0,0,0,c), img.width(), img.height(), 0, img.height());
+		}
+
+		return;
+	}
+
+	if (!isConstantTime(img, n))
+	{
+		res = img.get_blur_median(n);
+		return;
+	}
+
+	res.assign(img.width(), img.height(), 1, img.spectrum());
+
+	const int hl = n / 2;
+	const int hr = hl - 1 + n % 2;
+	const bool replicate = (n == 5);
+	const unsigned int strips = (img.width() + stripWidth - 1) / stripWidth;
+	const unsigned int taskCount = strips * img.spectrum();
+
+	auto filterTask = [&](unsigned int task, Buffers &taskBuffers)
+	{
+		const unsigned int c = task / strips;
+		const unsigned int strip = task % strips;
+
+		filterStrip((const unsigned char*)img.data(0,0,0,c), (unsigned char*)res.data(0,0,0,c), img.width(), img.height(),
+			strip * stripWidth, std::min<unsigned int>(img.width(), (strip + 1) * stripWidth), hl, hr, replicate, taskBuffers);
+	};
+
+	if (pool && taskCount > 1)
+	{
+		pool->parallelFor(taskCount, [&](unsigned int task)
+		{
+			Buffers taskBuffers;
+			filterTask(task, taskBuffers);
+		});
+	}
+	else
+	{
+		Buffers localBuffers;
+		Buffers &serialBuffers = buffers ? *buffers : localBuffers;
+
+		for (unsigned int task = 0; task < taskCount; task++)
+		{
+			filterTask(task, serialBuffers);
+		}
+	}
+}
+
+///
+/// @brief Returns the median filtered image (same result as CImg::get_blur_median(n)).
+/// @param img The image
+/// @param n The size of the kernel
+/// @param pool The thread pool that filters the strips of all channels (0 = serial)
+///
+template<typename T>
+cimg_library::CImg<T> blurMedian(const cimg_library::CImg<T> &img, unsigned int n, ThreadPool *pool = 0)
+{
+	cimg_library::CImg<T> res;
+	blurMedian(img, n, res, pool);
+	return res;
+}
+
+} // end namespace median
+
+} // end namespace lime
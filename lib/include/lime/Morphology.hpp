@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file Morphology.hpp
+/// @brief Contains the van Herk / Gil-Werman erosion and dilation with square kernels
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <CImg.h>
+#include <cstddef>
+
+namespace lime
+{
+
+///
+/// @namespace morphology
+/// @brief Erosion and dilation with square kernels whose cost per pixel does not depend on the kernel size.
+///
+/// @details Every axis is filtered with the van Herk / Gil-Werman algorithm: the line is split into blocks of the window length, a running
+/// minimum (maximum) is computed forwards and backwards inside every block and the result of a window is the combination of one forward and
+/// one backward value. The kernels are anchored like the ones of CImg and windows are clipped at the image border, so erode(img, size) gives
+/// the same result as CImg::erode(size) as long as the kernel is smaller than the image. Repeating a filter count times is the same as one
+/// filter with a window that is count times as wide on each side, so the count does not cost anything either.
+///
+namespace morphology
+{
+
+///
+/// @brief Minimum of two values (erosion)
+///
+template<typename T> struct MinOp
+{
+	inline T operator()(const T &a, const T &b) const { return b < a ? b : a; }
+	static inline T identity() { return cimg_library::cimg::type<T>::max(); }
+};
+
+///
+/// @brief Maximum of two values (dilation)
+///
+template<typename T> struct MaxOp
+{
+	inline T operator()(const T &a, const T &b) const { return a < b ? b : a; }
+	static inline T identity() { return cimg_library::cimg::type<T>::min(); }
+};
+
+///
+/// @brief Bitwise OR of two words (dilation of bit-packed masks)
+///
+template<typename T> struct BitOrOp
+{
+	inline T operator()(const T &a, const T &b) const { return a | b; }
+	static inline T identity() { return 0; }
+};
+
+///
+/// @brief Filters lanes parallel lines with a window [i - before, i + after] that is clipped at both ends of the lines.
+/// @param data Element i of lane l is data[i*step + l]
+/// @param length The number of elements of each line
+/// @param step The distance between two consecutive elements of a line
+/// @param lanes The number of lines that are filtered together (they have to be stored next to each other)
+/// @param before The number of elements before the center of the window
+/// @param after The number of elements after the center of the window
+/// @param forward Buffer for the forward running values (enlarged as needed)
+/// @param backward Buffer for the backward running values (enlarged as needed)
+///
+template<typename T, typename Op>
+void filterLines(T *data, unsigned int length, std::size_t step, unsigned int lanes, unsigned int before, unsigned int after, cimg_library::CImg<T> &forward, cimg_library::CImg<T> &backward)
+{
+	const Op op = Op();
+	const T identity = Op::identity();
+
+	// The lines are padded with the identity, which clips the windows at the border
+	const unsigned int window = before + after + 1;
+	const unsigned int padded = length + before + after;
+
+	if (forward.size() < (std::size_t)padded * lanes)
+	{
+		forward.assign(padded * lanes);
+		backward.assign(padded * lanes);
+	}
+
+	// Running values from the start of each block
+	for (unsigned int j = 0, pos = 0; j < padded; j++, pos = (pos + 1 == window) ? 0 : pos + 1)
+	{
+		const T *src = (j < before || j >= before + length) ? 0 : data + (std::size_t)(j - before) * step;
+		T *dst = forward.data() + (std::size_t)j * lanes;
+
+		if (pos == 0)
+		{
+			for (unsigned int l = 0; l < lanes; l++)
+			{
+				dst[l] = src ? src[l] : identity;
+			}
+		}
+		else
+		{
+			const T *prev = dst - lanes;
+
+			for (unsigned int l = 0; l < lanes; l++)
+			{
+				dst[l] = op(prev[l], src ? src[l] : identity);
+			}
+		}
+	}
+
+	// Running values from the end of each block
+	for (unsigned int j = padded; j-- > 0;)
+	{
+		const T *src = (j < before || j >= before + length) ? 0 : data + (std::size_t)(j - before) * step;
+		T *dst = backward.data() + (std::size_t)j * lanes;
+
+		if (j + 1 == padded || (j + 1) % window == 0)
+		{
+			for (unsigned int l = 0; l < lanes; l++)
+			{
+				dst[l] = src ? src[l] : identity;
+			}
+		}
+		else
+		{
+			const T *next = dst + lanes;
+
+			for (unsigned int l = 0; l < lanes; l++)
+			{
+				dst[l] = op(next[l], src ? src[l] : identity);
+			}
+		}
+	}
+
+	// The window of element i covers the padded elements [i, i + window - 1]
+	for (unsigned int i = 0; i < length; i++)
+	{
+		const T *b = backward.data() + (std::size_t)i * lanes;
+		const T *f = forward.data() + (std::size_t)(i + window - 1) * lanes;
+		T *dst = data + (std::size_t)i * step;
+
+		for (unsigned int l = 0; l < lanes; l++)
+		{
+			dst[l] = op(b[l], f[l]);
+		}
+	}
+}
+
+///
+/// @brief Filters every 2D plane of the image separably with a square window [p - before, p + after] along X and Y.
+///
+template<typename T, typename Op>
+void filterSquare(cimg_library::CImg<T> &img, unsigned int before, unsigned int after)
+{
+	if (img.is_empty() || before + after == 0)
+	{
+		return;
+	}
+
+	cimg_library::CImg<T> forward, backward;
+
+	cimg_forZC(img,z,c)
+	{
+		// Along X-axis (row by row)
+		if (img.width() > 1)
+		{
+			cimg_forY(img,y)
+			{
+				filterLines<T,Op>(img.data(0,y,z,c), img.width(), 1, 1, before, after, forward, backward);
+			}
+		}
+
+		// Along Y-axis (all columns at once, so the rows are read sequentially)
+		if (img.height() > 1)
+		{
+			filterLines<T,Op>(img.data(0,0,z,c), img.height(), img.width(), img.width(), before, after, forward, backward);
+		}
+	}
+}
+
+///
+/// @brief Erodes the image count times with a square kernel of the given size (same anchor as CImg::erode).
+/// @param img The image (every 2D plane is filtered independently)
+/// @param size The size of the square kernel
+/// @param count The number of times the erosion is applied
+///
+template<typename T>
+void erode(cimg_library::CImg<T> &img, unsigned int size, unsigned int count = 1)
+{
+	if (size > 1)
+	{
+		filterSquare<T, MinOp<T> >(img, count * (size / 2), count * (size - size / 2 - 1));
+	}
+}
+
+///
+/// @brief Dilates the image count times with a square kernel of the given size (same anchor as CImg::dilate).
+/// @param img The image (every 2D plane is filtered independently)
+/// @param size The size of the square kernel
+/// @param count The number of times the dilation is applied
+///
+template<typename T>
+void dilate(cimg_library::CImg<T> &img, unsigned int size, unsigned int count = 1)
+{
+	if (size > 1)
+	{
+		filterSquare<T, MaxOp<T> >(img, count * (size - size / 2 - 1), count * (size / 2));
+	}
+}
+
+///
+/// @brief Returns true if erode and dilate give the same result as the corresponding CImg functions for this image and kernel size.
+/// @details CImg does not clip the windows consistently if the kernel is at least as big as the image (and always filters along Z as well).
+///
+template<typename T>
+inline bool matchesCImg(const cimg_library::CImg<T> &img, unsigned int size)
+{
+	return img.depth() == 1 && (img.width() <= 1 || (unsigned int)img.width() > size) && (img.height() <= 1 || (unsigned int)img.height() > size);
+}
+
+} // end namespace morphology
+
+} // end namespace lime
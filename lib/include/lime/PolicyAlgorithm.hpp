@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file PolicyAlgorithm.hpp
+/// @brief Contains the PolicyAlgorithm class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/Algorithm.hpp>
+#include <lime/Classifier.hpp>
+
+namespace lime{
+
+	///
+	/// @class   PolicyAlgorithm
+	///
+	/// @version 0.3.0
+	///
+	/// @brief Subclass of Algorithm whose classifier is a compile-time parameter
+	///
+	/// @detail The transformation and the thresholds are taken from the classifier policy C (e.g. YCbCrClassifier<T>, HSVClassifier<T> or HSIClassifier<T>).
+	/// classifyRow calls them without virtual dispatch, so the compiler can inline and vectorize the loop. The class is an ordinary Algorithm, so it can be
+	/// handed to Segmentation like the runtime polymorphic algorithms and gives the same masks as the matching Colorimetric algorithm.
+	///
+	/// @date    Oct 16, 2026 - First creation
+	///
+	template<typename T, class C> class PolicyAlgorithm: public Algorithm<T>{
+
+	public:
+
+		///
+		/// @brief The constructor that passes all arguments but the classifier to the constructor of the base class
+		///
+		PolicyAlgorithm(const C &_classifier = C(), bool _applyMedian = false, unsigned int _medianSize = 3, bool _applyGrow = false, unsigned int _growCount = 1, unsigned int _growSize = 2,
+			bool _applyShrink = false, unsigned int _shrinkCount = 1, unsigned int _shrinkSize = 2, bool _applyFixedGrowShrink = false, unsigned int _fixedGrowShrinkCount = 1,
+			unsigned int _fixedGrowShrinkSize = 2, bool _applyGrowBeforeShrink = true, bool _applyRegionClearing = false)
+			:Algorithm<T>(_applyMedian,_medianSize, _applyGrow, _growCount, _growSize, _applyShrink, _shrinkCount, _shrinkSize, _applyFixedGrowShrink, _fixedGrowShrinkCount, _fixedGrowShrinkSize,
+			_applyGrowBeforeShrink, _applyRegionClearing), classifier(_classifier){}
+
+		///
+		/// @brief Basis destructor
+		///
+		virtual ~PolicyAlgorithm(){}
+
+		// Getter / Setter
+
+		virtual const C& Classifier() const { return this->classifier; } ///< Returns the classifier policy with its thresholds.
+		virtual void Classifier(const C &val) { this->classifier = val; this->invalidateLookupTable(); } ///< Can be used to replace the classifier policy (e.g. to change its thresholds).
+
+	protected:
+
+		// virtual functions
+
+		///
+		/// @brief Transforms the image data from the RGB color space to the color space of the classifier.
+		///
+		virtual CImg<double>* transformImage(const CImg<T> &img);
+
+		///
+		/// @brief Uses the thresholds of the classifier to determine whether a pixel is skin or non-skin.
+		/// @return true = skin, false = no skin
+		///
+		virtual bool skinThresholds(double c1, double c2, double c3);
+
+		///
+		/// @brief Classifies the row with the SIMD kernel of the classifier or with the statically dispatched loop.
+		///
+		virtual void classifyRow(const T *r, const T *g, const T *b, unsigned int count, bool *mask);
+
+		C classifier;
+
+	};
+
+}
+
+template<typename T, class C>
+CImg<double>* lime::PolicyAlgorithm<T,C>::transformImage(const CImg<T> &img )
+{
+	CImg<double> *resImg = new CImg<double>();
+	*resImg = C::transformImage(img);
+
+	return resImg;
+}
+
+template<typename T, class C>
+bool lime::PolicyAlgorithm<T,C>::skinThresholds( double c1, double c2, double c3 )
+{
+	return this->classifier(c1,c2,c3);
+}
+
+template<typename T, class C>
+void lime::PolicyAlgorithm<T,C>::classifyRow( const T *r, const T *g, const T *b, unsigned int count, bool *mask )
+{
+	if (this->classifier.classifyVectorized(r, g, b, count, mask, this->applyVectorization))
+	{
+		return;
+	}
+
+	lime::classifyRowStatic(this->classifier, r, g, b, count, mask);
+}
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file RegionTable.hpp
+/// @brief Contains the RegionTable struct
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+
+namespace lime
+{
+
+///
+/// @struct RegionTable
+///
+/// @version 0.3.0
+///
+/// @brief Area, bounding box, centroid, second order central moments and mean color of every region of a bit mask, stored as one array per value.
+///
+/// @details Entry i belongs to the region with label i + 1, the regions are numbered in raster order of their first pixel. The values are
+/// accumulated pixel by pixel with add / addColor (the centroid, moment and color arrays hold sums until finish() is called), so a labeling pass
+/// can fill the table without another pass over the image. Tables of row bands are combined with merge before finish() is called.
+///
+/// @date Oct 16, 2026 - First creation
+///
+struct RegionTable
+{
+	///
+	/// @brief Returns the number of regions
+	///
+	inline std::size_t size() const { return area.size(); }
+
+	///
+	/// @brief Removes all regions (the memory is kept)
+	///
+	void clear()
+	{
+		area.clear();
+		minX.clear();
+		minY.clear();
+		maxX.clear();
+		maxY.clear();
+		centroidX.clear();
+		centroidY.clear();
+		mu20.clear();
+		mu11.clear();
+		mu02.clear();
+		meanR.clear();
+		meanG.clear();
+		meanB.clear();
+	}
+
+	///
+	/// @brief Appends an empty region
+	///
+	void push()
+	{
+		area.push_back(0);
+		minX.push_back(std::numeric_limits<unsigned int>::max());
+		minY.push_back(std::numeric_limits<unsigned int>::max());
+		maxX.push_back(0);
+		maxY.push_back(0);
+		centroidX.push_back(0.0);
+		centroidY.push_back(0.0);
+		mu20.push_back(0.0);
+		mu11.push_back(0.0);
+		mu02.push_back(0.0);
+		meanR.push_back(0.0);
+		meanG.push_back(0.0);
+		meanB.push_back(0.0);
+	}
+
+	///
+	/// @brief Adds the pixel (x,y) to region i
+	///
+	inline void add(std::size_t i, unsigned int x, unsigned int y)
+	{
+		const double dx = x, dy = y;
+
+		area[i]++;
+		minX[i] = std::min(minX[i], x);
+		minY[i] = std::min(minY[i], y);
+		maxX[i] = std::max(maxX[i], x);
+		maxY[i] = std::max(maxY[i], y);
+		centroidX[i] += dx;
+		centroidY[i] += dy;
+		mu20[i] += dx * dx;
+		mu11[i] += dx * dy;
+		mu02[i] += dy * dy;
+	}
+
+	///
+	/// @brief Adds the color of a pixel to region i (called together with add)
+	///
+	inline void addColor(std::size_t i, double r, double g, double b)
+	{
+		meanR[i] += r;
+		meanG[i] += g;
+		meanB[i] += b;
+	}
+
+	///
+	/// @brief Adds region j of another table that has not been finished yet to region i
+	///
+	void merge(std::size_t i, const RegionTable &other, std::size_t j)
+	{
+		area[i] += other.area[j];
+		minX[i] = std::min(minX[i], other.minX[j]);
+		minY[i] = std::min(minY[i], other.minY[j]);
+		maxX[i] = std::max(maxX[i], other.maxX[j]);
+		maxY[i] = std::max(maxY[i], other.maxY[j]);
+		centroidX[i] += other.centroidX[j];
+		centroidY[i] += other.centroidY[j];
+		mu20[i] += other.mu20[j];
+		mu11[i] += other.mu11[j];
+		mu02[i] += other.mu02[j];
+		meanR[i] += other.meanR[j];
+		meanG[i] += other.meanG[j];
+		meanB[i] += other.meanB[j];
+	}
+
+	///
+	/// @brief Turns the accumulated sums into the centroids, central moments and mean colors
+	///
+	void finish()
+	{
+		for (std::size_t i = 0; i < area.size(); i++)
+		{
+			const double n = area[i];
+
+			centroidX[i] /= n;
+			centroidY[i] /= n;
+			mu20[i] = mu20[i] / n - centroidX[i] * centroidX[i];
+			mu11[i] = mu11[i] / n - centroidX[i] * centroidY[i];
+			mu02[i] = mu02[i] / n - centroidY[i] * centroidY[i];
+			meanR[i] /= n;
+			meanG[i] /= n;
+			meanB[i] /= n;
+		}
+	}
+
+	///
+	/// @brief Exchanges the contents with another table (without copying)
+	///
+	void swap(RegionTable &other)
+	{
+		area.swap(other.area);
+		minX.swap(other.minX);
+		minY.swap(other.minY);
+		maxX.swap(other.maxX);
+		maxY.swap(other.maxY);
+		centroidX.swap(other.centroidX);
+		centroidY.swap(other.centroidY);
+		mu20.swap(other.mu20);
+		mu11.swap(other.mu11);
+		mu02.swap(other.mu02);
+		meanR.swap(other.meanR);
+		meanG.swap(other.meanG);
+		meanB.swap(other.meanB);
+	}
+
+	///
+	/// @brief Returns the number of bytes held by the table
+	///
+	std::size_t footprint() const
+	{
+		return (area.capacity() + minX.capacity() + minY.capacity() + maxX.capacity() + maxY.capacity()) * sizeof(unsigned int)
+			+ (centroidX.capacity() + centroidY.capacity() + mu20.capacity() + mu11.capacity() + mu02.capacity()
+			+ meanR.capacity() + meanG.capacity() + meanB.capacity()) * sizeof(double);
+	}
+
+	///
+	/// @brief Gives back the memory of the table
+	///
+	void release()
+	{
+		RegionTable empty;
+		swap(empty);
+	}
+
+	std::vector<unsigned int> area;		///< The number of pixels
+	std::vector<unsigned int> minX;		///< The first column of the bounding box
+	std::vector<unsigned int> minY;		///< The first row of the bounding box
+	std::vector<unsigned int> maxX;		///< The last column of the bounding box
+	std::vector<unsigned int> maxY;		///< The last row of the bounding box
+	std::vector<double> centroidX;		///< The mean column of the pixels
+	std::vector<double> centroidY;		///< The mean row of the pixels
+	std::vector<double> mu20;			///< The variance of the columns (second order central moment divided by the area)
+	std::vector<double> mu11;			///< The covariance of columns and rows (second order central moment divided by the area)
+	std::vector<double> mu02;			///< The variance of the rows (second order central moment divided by the area)
+	std::vector<double> meanR;			///< The mean red value (0 if no colors were given)
+	std::vector<double> meanG;			///< The mean green value (0 if no colors were given)
+	std::vector<double> meanB;			///< The mean blue value (0 if no colors were given)
+};
+
+} // end namespace lime
@@ -54,6 +54,13 @@ namespace lime
 /// @date Oct 29, 2012 - First creation
 /// @date Nov 13, 2012 - Basic structure
 /// @date Nov 23, 2012 - Some small adjustments including the possibility to retrieve a mask as alpha channel
+/// @date Oct 16, 2026 - Forwarding functions for the classification and post-processing steps (used by subclasses)
+/// @date Oct 16, 2026 - Masks of non-owning image views
+/// @date Oct 16, 2026 - Masks written into a caller-owned CImg, so a video loop does not allocate memory for every frame
+/// @date Oct 16, 2026 - Stage times and counters of the algorithm
+/// @date Oct 16, 2026 - Masks restricted to regions of interest (rectangles or a prior mask)
+/// @date Oct 16, 2026 - Ordered border seeds by border following
+/// @date Oct 16, 2026 - Region statistics of the last mask
 /// @tparam T - Can be of any basic data type and should be the same as the one of the input image (e.g. double or char).
 ///
 template<typename T = int> class Segmentation
@@ -99,6 +106,75 @@ public:
 	///
 	inline CImg<bool>* retrieveMask_asBinaryChannel(const CImg<T> &img){return algorithm->processImage(img);}
 
+	///
+	/// @brief Processes image data that is owned by someone else (e.g. an interleaved camera buffer) without copying it, and delivers a binary mask (1 == skin pixel, 0 == no-skin pixel) with the width and height of the view.
+	/// @param view The image data that should be processed
+	/// @return The new bit mask
+	///
+	inline CImg<bool>* retrieveMask_asBinaryChannel(const ImageView<T> &view){return algorithm->processView(view);}
+
+	///
+	/// @brief Processes the image and writes the binary mask (1 == skin pixel, 0 == no-skin pixel) into a mask owned by the caller, whose memory is reused.
+	/// @param img The image data that should be processed
+	/// @param mask Receives the bit mask with the width and height of the image
+	///
+	inline void retrieveMask_asBinaryChannel(const CImg<T> &img, CImg<bool> &mask){algorithm->processImage(img,mask);}
+
+	///
+	/// @brief Processes image data that is owned by someone else without copying it, and writes the binary mask (1 == skin pixel, 0 == no-skin pixel) into a mask owned by the caller, whose memory is reused.
+	/// @param view The image data that should be processed
+	/// @param mask Receives the bit mask with the width and height of the view
+	///
+	inline void retrieveMask_asBinaryChannel(const ImageView<T> &view, CImg<bool> &mask){algorithm->processView(view,mask);}
+
+	///
+	/// @brief Processes only the regions of interest of the image (e.g. the rectangles of a hand or face detector), so the time depends on their area instead of the image size.
+	/// @param img The image data that should be processed
+	/// @param regions The regions of interest (clipped to the image, they may overlap)
+	/// @param mask Receives the bit mask with the width and height of the image (1 == skin pixel, 0 == no-skin pixel or outside of the regions)
+	///
+	inline void retrieveMask_ofRegions(const CImg<T> &img, const std::vector<Rect2D> &regions, CImg<bool> &mask){algorithm->processRegions(ImageView<T>(img),regions,mask);}
+
+	///
+	/// @brief Processes only the regions of interest of image data that is owned by someone else, without copying it.
+	/// @param view The image data that should be processed
+	/// @param regions The regions of interest (clipped to the view, they may overlap)
+	/// @param mask Receives the bit mask with the width and height of the view (1 == skin pixel, 0 == no-skin pixel or outside of the regions)
+	///
+	inline void retrieveMask_ofRegions(const ImageView<T> &view, const std::vector<Rect2D> &regions, CImg<bool> &mask){algorithm->processRegions(view,regions,mask);}
+
+	///
+	/// @brief Processes only the regions of interest of the image and delivers one binary mask per region.
+	/// @param img The image data that should be processed
+	/// @param regions The regions of interest (clipped to the image)
+	/// @param masks Receives a bit mask with the size of each clipped region (empty if the region lies outside of the image)
+	///
+	inline void retrieveMask_ofRegions(const CImg<T> &img, const std::vector<Rect2D> &regions, std::vector< CImg<bool> > &masks){algorithm->processRegions(ImageView<T>(img),regions,masks);}
+
+	///
+	/// @brief Processes only the regions of interest of image data that is owned by someone else and delivers one binary mask per region.
+	/// @param view The image data that should be processed
+	/// @param regions The regions of interest (clipped to the view)
+	/// @param masks Receives a bit mask with the size of each clipped region (empty if the region lies outside of the view)
+	///
+	inline void retrieveMask_ofRegions(const ImageView<T> &view, const std::vector<Rect2D> &regions, std::vector< CImg<bool> > &masks){algorithm->processRegions(view,regions,masks);}
+
+	///
+	/// @brief Processes only the pixels of the image where a prior mask (e.g. a coarse detector grid) is true.
+	/// @param img The image data that should be processed
+	/// @param prior The prior mask (can be coarser than the image, see getRegionsOfInterest)
+	/// @param mask Receives the bit mask with the width and height of the image (1 == skin pixel, 0 == no-skin pixel or outside of the prior mask)
+	///
+	inline void retrieveMask_ofRegions(const CImg<T> &img, const CImg<bool> &prior, CImg<bool> &mask){algorithm->processRegions(ImageView<T>(img),prior,mask);}
+
+	///
+	/// @brief Processes only the pixels of image data that is owned by someone else where a prior mask is true.
+	/// @param view The image data that should be processed
+	/// @param prior The prior mask (can be coarser than the view, see getRegionsOfInterest)
+	/// @param mask Receives the bit mask with the width and height of the view (1 == skin pixel, 0 == no-skin pixel or outside of the prior mask)
+	///
+	inline void retrieveMask_ofRegions(const ImageView<T> &view, const CImg<bool> &prior, CImg<bool> &mask){algorithm->processRegions(view,prior,mask);}
+
 	///
 	/// @brief Processes the image and then adds the skin segmentation as an alpha channel (255 == skin, 0 == no-skin-pixel) to the original image.
 	/// @param img The image data that should be processed
@@ -175,13 +251,86 @@ public:
 		return algorithm->getSeeds(false,singleRegion,mask,appyDilation,dilationCount,dilationSize);
 	}
 
+	///
+	/// @brief Uses a bit mask to determine the seed points on the borders of the skin regions, ordered along each border, in a single pass
+	/// @param mask The bit mask
+	/// @param seeds Receives the seeds, border after border (its memory is reused)
+	/// @param contours Receives the borders (outer borders and hole borders) with their region and the range of their seeds (its memory is reused)
+	/// @param singleRegion Only determines the seed pixels of the outer border of the first region that is being detected
+	/// @param stride Only every stride-th pixel of a border becomes a seed
+	/// @param applyErosion True if a shrink algorithm should be used prior to the seed pixel detection
+	/// @param erosionCount Number of times the shrink algorithm should be used
+	/// @param erosionSize Size of the kernel for the shrink algorithm
+	///
+	inline void retrieveSkinContoursOfMask(const CImg<bool> &mask, std::vector<BinarySeed> &seeds, std::vector<contour::Contour> &contours, bool singleRegion = false,
+		unsigned int stride = 1, bool applyErosion = true, unsigned int erosionCount = 1, unsigned int erosionSize = 3)
+	{
+		algorithm->getContourSeeds(true,singleRegion,mask,applyErosion,erosionCount,erosionSize,stride,seeds,contours);
+	}
+
+	///
+	/// @brief Uses a bit mask to determine the non-skin seed points around the skin regions, ordered along each border, in a single pass
+	/// @param mask The bit mask
+	/// @param seeds Receives the seeds, border after border (its memory is reused)
+	/// @param contours Receives the borders with their region and the range of their seeds (its memory is reused)
+	/// @param singleRegion Only determines the seed pixels of the border around the first skin region that is being detected
+	/// @param stride Only every stride-th pixel of a border becomes a seed
+	/// @param applyDilation True if a grow algorithm should be used prior to the seed pixel detection
+	/// @param dilationCount Number of times the grow algorithm should be used
+	/// @param dilationSize Size of the kernel for the grow algorithm
+	///
+	inline void retrieveNonSkinContoursOfMask(const CImg<bool> &mask, std::vector<BinarySeed> &seeds, std::vector<contour::Contour> &contours, bool singleRegion = false,
+		unsigned int stride = 1, bool applyDilation = true, unsigned int dilationCount = 1, unsigned int dilationSize = 3)
+	{
+		algorithm->getContourSeeds(false,singleRegion,mask,applyDilation,dilationCount,dilationSize,stride,seeds,contours);
+	}
+
 	inline CImg<int>* retrieveDistanceMapOfMask(CImg<bool> &mask, bool singleRegion = false)
 	{
 		return algorithm->getDistanceMapOfMask(mask,singleRegion);
 	}
 
+	///
+	/// @brief Returns the stage times and counters of the last image processed by retrieveMask_* (Algorithm::CollectStatistics has to be activated).
+	///
+	inline const Statistics& retrieveStatistics() const {return algorithm->LastStatistics();}
+
+	///
+	/// @brief Returns the stage times and counters summed over all images processed since Algorithm::ResetStatistics.
+	///
+	inline const Statistics& retrieveTotalStatistics() const {return algorithm->TotalStatistics();}
+
+	///
+	/// @brief Returns the area, bounding box, centroid, central moments and mean color of each skin region of the last image processed by retrieveMask_*
+	/// (Algorithm::CollectRegionStatistics has to be activated). The regions are the ones of the classified mask, before region clearing and grow / shrink.
+	///
+	inline const RegionTable& retrieveRegions() const {return algorithm->LastRegions();}
+
 protected:
 
+	// Forwarding functions for subclasses (the friendship with Algorithm is not inherited)
+
+	///
+	/// @brief Prepares the algorithm for classifyPixels (builds its lookup table if needed)
+	///
+	inline void prepareClassification(){algorithm->prepareClassification();}
+
+	///
+	/// @brief Transforms and classifies a single row of pixels with the algorithm
+	/// @param r The first channel of the row (R)
+	/// @param g The second channel of the row (G)
+	/// @param b The third channel of the row (B)
+	/// @param count The number of pixels in the row
+	/// @param mask The row of the bit mask that receives the result
+	///
+	inline void classifyPixels(const T *r, const T *g, const T *b, unsigned int count, bool *mask){algorithm->classifyPixels(r,g,b,count,mask);}
+
+	///
+	/// @brief Applies region clearing and the grow / shrink algorithms of the algorithm to a classified bit mask
+	/// @param mask The bit mask
+	///
+	inline void postprocessMask(CImg<bool> *mask){algorithm->postprocessMask(mask);}
+
 	///
 	/// @brief The internal algorithm that is used to process an image and generate a bit mask
 	///
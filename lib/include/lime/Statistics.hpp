@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file Statistics.hpp
+/// @brief Contains the Statistics struct and the StageTimer class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <chrono>
+#include <cstddef>
+
+namespace lime
+{
+
+///
+/// @struct Statistics
+///
+/// @version 0.3.0
+///
+/// @brief Wall times and counters of the stages of a segmentation.
+///
+/// @details The times of stages that run in row bands on the thread pool are the times of the slowest band, so the stage times add up to about
+/// the wall time of the whole call.
+///
+/// @date Oct 16, 2026 - First creation
+///
+struct Statistics
+{
+	///
+	/// @brief The stages of a segmentation
+	///
+	enum Stage
+	{
+		StageMedian,			///< Median filter (including the copy of the rows out of the image)
+		StageClassification,	///< Transformation and thresholds (or lookup table)
+		StageLabeling,			///< Region labeling and region clearing
+		StageMorphology,		///< Grow / shrink algorithms
+		StageCount				///< The number of stages
+	};
+
+	Statistics() { reset(); }
+
+	///
+	/// @brief Sets all times and counters to 0
+	///
+	void reset()
+	{
+		for (unsigned int i = 0; i < StageCount; i++)
+		{
+			seconds[i] = 0.0;
+		}
+
+		totalSeconds = 0.0;
+		calls = 0;
+		pixels = 0;
+		skinPixels = 0;
+		evaluatedPixels = 0;
+		regions = 0;
+		labelMerges = 0;
+		bytesAllocated = 0;
+	}
+
+	///
+	/// @brief Adds the times and counters of other
+	///
+	Statistics& operator+=(const Statistics &other)
+	{
+		for (unsigned int i = 0; i < StageCount; i++)
+		{
+			seconds[i] += other.seconds[i];
+		}
+
+		totalSeconds += other.totalSeconds;
+		calls += other.calls;
+		pixels += other.pixels;
+		skinPixels += other.skinPixels;
+		evaluatedPixels += other.evaluatedPixels;
+		regions += other.regions;
+		labelMerges += other.labelMerges;
+		bytesAllocated += other.bytesAllocated;
+		return *this;
+	}
+
+	///
+	/// @brief Returns the name of a stage (e.g. for logging)
+	///
+	static const char* stageName(Stage stage)
+	{
+		static const char *names[StageCount] = { "median", "classification", "labeling", "morphology" };
+		return (stage < StageCount) ? names[stage] : "";
+	}
+
+	double seconds[StageCount];			///< The wall time of each stage in seconds
+	double totalSeconds;				///< The wall time of the whole call in seconds
+	unsigned long long calls;			///< The number of processed images
+	unsigned long long pixels;			///< The number of processed pixels
+	unsigned long long skinPixels;		///< The number of pixels that were classified as skin (before region clearing and the grow / shrink algorithms)
+	unsigned long long evaluatedPixels;	///< The number of pixels that were classified (less than pixels with coarse-to-fine classification, the classified mean colors of the coarse level are included)
+	unsigned long long regions;			///< The number of skin regions found by the region labeling (0 unless region clearing or CollectRegionStatistics is activated)
+	unsigned long long labelMerges;		///< The number of band-local regions that were merged with a region of another band (0 if labeled serially)
+	unsigned long long bytesAllocated;	///< The number of bytes the kept buffers (workspace, labels, lookup table) grew by, 0 once they fit the image size
+};
+
+///
+/// @class StageTimer
+///
+/// @version 0.3.0
+///
+/// @brief Adds the wall time between its construction and destruction to a time in seconds. Does not read the clock if the target is 0.
+///
+/// @date Oct 16, 2026 - First creation
+///
+class StageTimer
+{
+
+public:
+
+	///
+	/// @brief Starts the timer
+	/// @param _target The time the elapsed seconds are added to (0 = nothing is measured)
+	///
+	explicit StageTimer(double *_target):target(_target)
+	{
+		if (target)
+		{
+			start = std::chrono::steady_clock::now();
+		}
+	}
+
+	///
+	/// @brief Adds the elapsed time to the target
+	///
+	~StageTimer()
+	{
+		if (target)
+		{
+			*target += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+private:
+
+	StageTimer(const StageTimer&); ///< Not copyable
+	StageTimer& operator=(const StageTimer&); ///< Not copyable
+
+	double *target; ///< The time the elapsed seconds are added to
+	std::chrono::steady_clock::time_point start; ///< The time of the construction
+};
+
+} // end namespace lime
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file StreamSegmentation.hpp
+/// @brief Contains the StreamSegmentation class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/Algorithm.hpp>
+#include <CImg.h>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+using namespace cimg_library;
+
+namespace lime
+{
+
+///
+/// @class StreamSegmentation
+///
+/// @version 0.3.0
+///
+/// @brief Segments images row band by row band, so images of any height can be processed with a fixed amount of memory.
+///
+/// @details The scanlines are pulled from a source in order and the rows of the bit mask are handed to a sink in order as soon as they are final.
+/// Only a sliding window of the input (the current band plus the rows the median filter needs above and below it) and of the bit mask (the current
+/// band plus the rows the grow / shrink algorithms need) is kept in memory, so the memory does not depend on the height of the image.
+/// The resulting mask is identical to the one of Segmentation::retrieveMask_asBinaryChannel. Region clearing needs the whole mask at once and is
+/// therefore not supported.
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - Can be of any basic data type and should be the same as the one of the input image (e.g. double or char).
+///
+template<typename T = int> class StreamSegmentation
+{
+
+public:
+
+	///
+	/// @brief Fills row y of the image (the rows are requested in order, each of them exactly once)
+	/// @details Called with (y, r, g, b) where r, g and b point to the width values of the three channels of the row.
+	///
+	typedef std::function<void(unsigned int, T*, T*, T*)> RowSource;
+
+	///
+	/// @brief Receives row y of the bit mask (the rows are delivered in order, each of them exactly once)
+	/// @details Called with (y, mask) where mask points to the width values of the row (true = skin, false = no skin). The pointer is only valid during the call.
+	///
+	typedef std::function<void(unsigned int, const bool*)> RowSink;
+
+	///
+	/// @brief The constructor of StreamSegmentation that needs a skin segmentation algorithm passed to (Strategy pattern)
+	/// @param _algorithm The algorithm that classifies the pixels and post-processes the bit mask
+	/// @param _bandHeight The number of rows that are classified at once
+	///
+	StreamSegmentation(Algorithm<T>* _algorithm, unsigned int _bandHeight = 64):algorithm(_algorithm),bandHeight(std::max(1u, _bandHeight)){}
+
+	///
+	/// @brief The basic destructor
+	///
+	virtual ~StreamSegmentation(){}
+
+	///
+	/// @brief Can be used to switch the algorithm at runtime (Strategy Pattern)
+	/// @param algorithm The new algorithm that should be used to process the image data for skin segmentation
+	///
+	inline void switchAlgorithm(Algorithm<T>* _algorithm){algorithm = _algorithm;}
+
+	virtual unsigned int BandHeight() const { return bandHeight; } ///< Returns the number of rows that are classified at once.
+	virtual void BandHeight(unsigned int val) { bandHeight = std::max(1u, val); } ///< Can set the number of rows that are classified at once (bigger bands need more memory but fewer copies of the halo rows).
+
+	///
+	/// @brief Returns the maximal number of input rows that are kept in memory for the current settings of the algorithm.
+	///
+	inline unsigned int inputWindowRows() const { return bandHeight + 2 * medianHalo(); }
+
+	///
+	/// @brief Returns the maximal number of mask rows that are kept in memory for the current settings of the algorithm.
+	///
+	inline unsigned int maskWindowRows() const { return bandHeight + 2 * morphologyHalo(); }
+
+	///
+	/// @brief Pulls the image row by row from the source and delivers the bit mask row by row to the sink.
+	/// @param width The width of the image
+	/// @param height The height of the image
+	/// @param source Fills the requested row of the image
+	/// @param sink Receives the finished rows of the bit mask
+	/// @warning Throws std::runtime_error if region clearing is activated in the algorithm.
+	///
+	void process(unsigned int width, unsigned int height, const RowSource &source, const RowSink &sink);
+
+protected:
+
+	///
+	/// @brief Returns the number of input rows above and below a row that influence its median.
+	///
+	inline unsigned int medianHalo() const { return algorithm->applyMedian ? algorithm->medianSize / 2 : 0; }
+
+	///
+	/// @brief Returns the number of mask rows above and below a row that are processed together with it by the grow / shrink algorithms.
+	/// @details CImg treats windows that are not smaller than the image differently, so at least as many rows as the biggest kernel are added.
+	///
+	unsigned int morphologyHalo() const;
+
+	///
+	/// @brief Moves the window of rows [first,end) to the rows [newFirst,newEnd) and keeps the rows both have in common.
+	/// @details The rows after the old window are not initialized and have to be filled by the caller.
+	///
+	template<typename V>
+	static void slideWindow(CImg<V> &window, unsigned int &first, unsigned int &end, unsigned int newFirst, unsigned int newEnd, unsigned int width, unsigned int spectrum);
+
+	///
+	/// @brief The internal algorithm that is used to process an image and generate a bit mask
+	///
+	Algorithm<T>* algorithm;
+
+	///
+	/// @brief The number of rows that are classified at once
+	///
+	unsigned int bandHeight;
+
+};
+
+template<typename T>
+void lime::StreamSegmentation<T>::process( unsigned int width, unsigned int height, const RowSource &source, const RowSink &sink )
+{
+	if (algorithm->applyRegionClearing)
+	{
+		throw std::runtime_error("lime::StreamSegmentation: region clearing needs the whole mask and is not supported");
+	}
+
+	if (width == 0 || height == 0)
+	{
+		return;
+	}
+
+	// The lookup table has to be complete before the first row is classified
+	algorithm->prepareClassification();
+
+	const unsigned int inputHalo = medianHalo();
+	const unsigned int maskHalo = morphologyHalo();
+
+	CImg<T> input; // Rows [inputFirst,inputEnd) of the image
+	unsigned int inputFirst = 0, inputEnd = 0;
+
+	CImg<bool> mask; // Rows [maskFirst,maskEnd) of the bit mask before the grow / shrink algorithms
+	unsigned int maskFirst = 0, maskEnd = 0;
+
+	unsigned int emitted = 0; // The rows [0,emitted) are delivered to the sink
+
+	for (unsigned int y0 = 0; y0 < height; y0 += bandHeight)
+	{
+		const unsigned int y1 = std::min(height, y0 + bandHeight);
+
+		// The median of a row depends on inputHalo rows above and below it, so these rows have to be in the window as well
+		const unsigned int inputRead = inputEnd;
+		slideWindow(input, inputFirst, inputEnd, (y0 > inputHalo) ? y0 - inputHalo : 0, std::min(height, y1 + inputHalo), width, 3);
+
+		for (unsigned int y = inputRead; y < inputEnd; y++)
+		{
+			source(y, input.data(0,y-inputFirst,0,0), input.data(0,y-inputFirst,0,1), input.data(0,y-inputFirst,0,2));
+		}
+
+		CImg<T> medianImg;
+
+		if (algorithm->applyMedian)
+		{
+			// The bands are processed one after the other, so the strips of the median filter can use the thread pool
+			medianImg = median::blurMedian(input, algorithm->medianSize, algorithm->threadPoolInstance());
+		}
+
+		const CImg<T> &src = algorithm->applyMedian ? medianImg : input;
+
+		// The mask window keeps the rows the grow / shrink algorithms need above the next row that is delivered
+		slideWindow(mask, maskFirst, maskEnd, (emitted > maskHalo) ? emitted - maskHalo : 0, y1, width, 1);
+
+		for (unsigned int y = y0; y < y1; y++)
+		{
+			algorithm->classifyPixels(src.data(0,y-inputFirst,0,0), src.data(0,y-inputFirst,0,1), src.data(0,y-inputFirst,0,2), width, mask.data(0,y-maskFirst,0,0));
+		}
+
+		// A row is final as soon as the maskHalo rows below it are classified (or the image ends)
+		const unsigned int ready = (y1 == height) ? height : ((y1 > maskHalo) ? y1 - maskHalo : 0);
+
+		if (ready <= emitted)
+		{
+			continue;
+		}
+
+		const unsigned int cropFirst = (emitted > maskHalo) ? emitted - maskHalo : 0;
+		const unsigned int cropEnd = std::min(y1, ready + maskHalo);
+
+		CImg<bool> bandMask = mask.get_crop(0, cropFirst - maskFirst, 0, 0, width - 1, cropEnd - 1 - maskFirst, 0, 0);
+
+		algorithm->applyMorphology(&bandMask);
+
+		for (unsigned int y = emitted; y < ready; y++)
+		{
+			sink(y, bandMask.data(0,y-cropFirst,0,0));
+		}
+
+		emitted = ready;
+	}
+}
+
+template<typename T>
+unsigned int lime::StreamSegmentation<T>::morphologyHalo() const
+{
+	const unsigned int reach = algorithm->morphologyReach();
+
+	if (reach == 0)
+	{
+		return 0;
+	}
+
+	unsigned int kernel = 0;
+
+	if (algorithm->applyGrow || algorithm->applyShrink)
+	{
+		kernel = algorithm->growSize;
+	}
+
+	if (algorithm->applyFixedGrowShrink)
+	{
+		kernel = std::max(kernel, algorithm->fixedGrowShrinkSize);
+	}
+
+	return std::max(reach, kernel);
+}
+
+template<typename T>
+template<typename V>
+void lime::StreamSegmentation<T>::slideWindow( CImg<V> &window, unsigned int &first, unsigned int &end, unsigned int newFirst, unsigned int newEnd, unsigned int width, unsigned int spectrum )
+{
+	CImg<V> next(width, newEnd - newFirst, 1, spectrum);
+
+	const unsigned int keepFirst = std::max(first, newFirst);
+	const unsigned int keepEnd = std::min(end, newEnd);
+
+	if (keepFirst < keepEnd)
+	{
+		for (unsigned int c = 0; c < spectrum; c++)
+		{
+			std::memcpy(next.data(0,keepFirst-newFirst,0,c), window.data(0,keepFirst-first,0,c), (size_t)(keepEnd - keepFirst) * width * sizeof(V));
+		}
+	}
+
+	window.swap(next);
+	first = newFirst;
+	end = newEnd;
+}
+
+} // end namespace lime
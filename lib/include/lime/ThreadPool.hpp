@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file ThreadPool.hpp
+/// @brief Contains the ThreadPool class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace lime
+{
+
+///
+/// @class ThreadPool
+///
+/// @version 0.3.0
+///
+/// @brief A small pool of worker threads that executes indexed tasks in parallel.
+///
+/// @details The threads are created once and reused for every call of parallelFor, so the pool can be kept alive across many images.
+/// The calling thread takes part in the work, so a pool of size n starts n-1 worker threads. If the pool is already busy (e.g. parallelFor
+/// is called from inside a task or from a second thread) the tasks are executed serially by the caller instead of blocking.
+///
+/// @date Oct 16, 2026 - First creation
+///
+class ThreadPool
+{
+
+public:
+
+	///
+	/// @brief Creates the pool
+	/// @param threadCount The number of threads that work on a parallelFor call (including the calling thread). 0 uses all hardware threads.
+	///
+	ThreadPool(unsigned int threadCount = 0):task(0),taskCount(0),nextTask(0),activeWorkers(0),generation(0),stop(false)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::thread::hardware_concurrency();
+		}
+
+		for (unsigned int i = 1; i < threadCount; i++)
+		{
+			workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+		}
+	}
+
+	///
+	/// @brief Stops and joins all worker threads
+	///
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+
+		wakeCondition.notify_all();
+
+		for (unsigned int i = 0; i < workers.size(); i++)
+		{
+			workers[i].join();
+		}
+	}
+
+	///
+	/// @brief Returns the number of threads that work on a parallelFor call (including the calling thread)
+	///
+	inline unsigned int size() const { return (unsigned int)workers.size() + 1; }
+
+	///
+	/// @brief Calls _task(i) for every i in [0,_taskCount) and returns when all tasks are done. The tasks are distributed dynamically over the threads.
+	/// @param _taskCount The number of tasks
+	/// @param _task The function that processes a single task
+	/// @warning The first exception thrown by a task is rethrown after all tasks are finished.
+	///
+	void parallelFor(unsigned int _taskCount, const std::function<void(unsigned int)> &_task)
+	{
+		std::unique_lock<std::mutex> runLock(runMutex, std::try_to_lock);
+
+		// Runs serially if there are no workers or the pool is already in use
+		if (workers.empty() || _taskCount <= 1 || !runLock.owns_lock())
+		{
+			for (unsigned int i = 0; i < _taskCount; i++)
+			{
+				_task(i);
+			}
+
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			task = &_task;
+			taskCount = _taskCount;
+			nextTask = 0;
+			error = std::exception_ptr();
+			activeWorkers = (unsigned int)workers.size();
+			generation++;
+		}
+
+		wakeCondition.notify_all();
+
+		runTasks();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		doneCondition.wait(lock, [this]{ return activeWorkers == 0; });
+		task = 0;
+
+		if (error)
+		{
+			std::exception_ptr e = error;
+			error = std::exception_ptr();
+			std::rethrow_exception(e);
+		}
+	}
+
+private:
+
+	ThreadPool(const ThreadPool&); ///< Not copyable
+	ThreadPool& operator=(const ThreadPool&); ///< Not copyable
+
+	///
+	/// @brief Takes tasks until all tasks of the current call are taken
+	///
+	void runTasks()
+	{
+		for (;;)
+		{
+			unsigned int i;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+
+				if (nextTask >= taskCount)
+				{
+					return;
+				}
+
+				i = nextTask++;
+			}
+
+			try
+			{
+				(*task)(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+
+				if (!error)
+				{
+					error = std::current_exception();
+				}
+			}
+		}
+	}
+
+	///
+	/// @brief Main loop of a worker thread
+	///
+	void workerLoop()
+	{
+		unsigned long long seenGeneration = 0;
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeCondition.wait(lock, [&]{ return stop || generation != seenGeneration; });
+
+				if (stop)
+				{
+					return;
+				}
+
+				seenGeneration = generation;
+			}
+
+			runTasks();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				activeWorkers--;
+			}
+
+			doneCondition.notify_one();
+		}
+	}
+
+	std::vector<std::thread> workers; ///< The worker threads
+
+	std::mutex mutex; ///< Protects all members below
+	std::mutex runMutex; ///< Held during a parallelFor call
+	std::condition_variable wakeCondition; ///< Wakes the workers for a new call or for stopping
+	std::condition_variable doneCondition; ///< Signals the caller that a worker is done
+
+	const std::function<void(unsigned int)> *task; ///< The function of the current call
+	unsigned int taskCount; ///< Number of tasks of the current call
+	unsigned int nextTask; ///< The next task that is not taken yet
+	unsigned int activeWorkers; ///< Number of workers that still work on the current call
+	unsigned long long generation; ///< Incremented with every call, so the workers can detect a new call
+	bool stop; ///< True if the workers should stop
+	std::exception_ptr error; ///< The first exception thrown by a task of the current call
+};
+
+} // end namespace lime
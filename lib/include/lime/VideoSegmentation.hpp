@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file VideoSegmentation.hpp
+/// @brief Contains the VideoSegmentation class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/Segmentation.hpp>
+#include <CImg.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+using namespace cimg_library;
+
+namespace lime
+{
+
+///
+/// @class VideoSegmentation
+///
+/// @version 0.3.0
+///
+/// @brief Segmentation of frame sequences that only reclassifies the parts of a frame that changed since the previous frame.
+///
+/// @details The frames are split into square tiles. A tile counts as changed if one of its pixel values differs by more than the tolerance from
+/// the value it had when the tile was classified the last time. Only the changed tiles (plus the pixels whose median depends on them) are filtered
+/// and classified again, the rest of the classification is taken from the previous frame. Region clearing and the grow / shrink algorithms work on
+/// the whole mask and run for every frame in which something changed. With a tolerance of 0 the mask is identical to the one of
+/// retrieveMask_asBinaryChannel.
+///
+/// The state belongs to a single stream: call reset() when a new stream starts or a setting of the algorithm is changed.
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - Can be of any basic data type and should be the same as the one of the input image (e.g. double or char).
+///
+template<typename T = int> class VideoSegmentation : public Segmentation<T>
+{
+
+public:
+
+	///
+	/// @brief The constructor of VideoSegmentation that needs a skin segmentation algorithm passed to (Strategy pattern)
+	/// @param _algorithm The algorithm that classifies the pixels and post-processes the bit mask
+	/// @param _tileSize The width and height of the tiles that are compared between the frames
+	/// @param _tolerance The largest difference of a pixel value that does not count as a change
+	///
+	VideoSegmentation(Algorithm<T>* _algorithm, unsigned int _tileSize = 32, double _tolerance = 0.0)
+		:Segmentation<T>(_algorithm),tileSize(std::max(1u, _tileSize)),tolerance(_tolerance),changedTiles(0),tileCount(0){}
+
+	///
+	/// @brief The basic destructor
+	///
+	virtual ~VideoSegmentation(){}
+
+	///
+	/// @brief Can be used to switch the algorithm at runtime (Strategy Pattern). Starts a new stream.
+	/// @param algorithm The new algorithm that should be used to process the image data for skin segmentation
+	///
+	inline void switchAlgorithm(Algorithm<T>* _algorithm){this->algorithm = _algorithm; reset();}
+
+	virtual unsigned int TileSize() const { return tileSize; } ///< Returns the width and height of the tiles that are compared between the frames.
+	virtual void TileSize(unsigned int val) { tileSize = std::max(1u, val); reset(); } ///< Can set the width and height of the tiles that are compared between the frames (starts a new stream).
+
+	virtual double Tolerance() const { return tolerance; } ///< Returns the largest difference of a pixel value that does not count as a change.
+	virtual void Tolerance(double val) { tolerance = val; } ///< Can set the largest difference of a pixel value that does not count as a change (0 = every change is detected).
+
+	///
+	/// @brief Returns the number of tiles that were classified again for the last frame (all tiles for the first frame of a stream).
+	///
+	inline unsigned int ChangedTiles() const { return changedTiles; }
+
+	///
+	/// @brief Returns the number of tiles of the last frame.
+	///
+	inline unsigned int TileCount() const { return tileCount; }
+
+	///
+	/// @brief Forgets the previous frame, so the next frame is classified completely. Has to be called after a setting of the algorithm changed.
+	///
+	inline void reset()
+	{
+		previousFrame.assign();
+		rawMask.assign();
+		lastMask.assign();
+	}
+
+	///
+	/// @brief Processes the next frame of the stream and delivers a binary mask (1 == skin pixel, 0 == no-skin pixel) with the width and height of the frame.
+	/// @param frame The image data of the frame (RGB, a CImgArgumentException is thrown for less than 3 channels)
+	/// @return The new bit mask
+	///
+	CImg<bool>* retrieveMask_ofFrame(const CImg<T> &frame);
+
+protected:
+
+	///
+	/// @brief Filters and classifies the tiles [tx0,tx1] x [ty0,ty1] of the frame (including the pixels around them whose median depends on them)
+	///
+	void classifyTiles(const CImg<T> &frame, unsigned int tx0, unsigned int ty0, unsigned int tx1, unsigned int ty1);
+
+	///
+	/// @brief Returns true if a pixel value of the tile differs by more than the tolerance from the previous frame
+	///
+	bool tileChanged(const CImg<T> &frame, unsigned int tx, unsigned int ty) const;
+
+	///
+	/// @brief The width and height of the tiles that are compared between the frames
+	///
+	unsigned int tileSize;
+
+	///
+	/// @brief The largest difference of a pixel value that does not count as a change
+	///
+	double tolerance;
+
+	///
+	/// @brief The number of tiles that were classified again for the last frame
+	///
+	unsigned int changedTiles;
+
+	///
+	/// @brief The number of tiles of the last frame
+	///
+	unsigned int tileCount;
+
+	///
+	/// @brief The pixel values every tile had when it was classified the last time
+	///
+	CImg<T> previousFrame;
+
+	///
+	/// @brief The classification of the previous frame before region clearing and the grow / shrink algorithms
+	///
+	CImg<bool> rawMask;
+
+	///
+	/// @brief The bit mask of the previous frame
+	///
+	CImg<bool> lastMask;
+
+	///
+	/// @brief Marks the changed tiles of the current frame (row by row)
+	///
+	std::vector<unsigned char> changed;
+
+};
+
+template<typename T>
+CImg<bool>* lime::VideoSegmentation<T>::retrieveMask_ofFrame( const CImg<T> &frame )
+{
+	checkChannels(frame.spectrum(), "lime::VideoSegmentation::retrieveMask_ofFrame()");
+
+	// Volumes are not split into tiles
+	if (frame.depth() != 1)
+	{
+		reset();
+		return this->retrieveMask_asBinaryChannel(frame);
+	}
+
+	const unsigned int width = frame.width();
+	const unsigned int height = frame.height();
+	const unsigned int tilesX = (width + tileSize - 1) / tileSize;
+	const unsigned int tilesY = (height + tileSize - 1) / tileSize;
+
+	tileCount = tilesX * tilesY;
+
+	this->prepareClassification();
+
+	// A new stream (or a new frame size) starts with a complete classification
+	if (previousFrame.width() != frame.width() || previousFrame.height() != frame.height() || previousFrame.depth() != 1 || previousFrame.spectrum() != frame.spectrum())
+	{
+		previousFrame = frame;
+		rawMask.assign(width, height, 1, 1);
+
+		if (tileCount > 0)
+		{
+			classifyTiles(frame, 0, 0, tilesX - 1, tilesY - 1);
+		}
+
+		changedTiles = tileCount;
+		lastMask = rawMask;
+		this->postprocessMask(&lastMask);
+
+		return new CImg<bool>(lastMask);
+	}
+
+	changed.assign(tileCount, 0);
+	changedTiles = 0;
+
+	for (unsigned int ty = 0; ty < tilesY; ty++)
+	{
+		for (unsigned int tx = 0; tx < tilesX; tx++)
+		{
+			if (tileChanged(frame, tx, ty))
+			{
+				changed[ty * tilesX + tx] = 1;
+				changedTiles++;
+			}
+		}
+	}
+
+	if (changedTiles == 0)
+	{
+		return new CImg<bool>(lastMask);
+	}
+
+	// Neighbouring changed tiles of a tile row are classified together, so their median halo is only filtered once
+	for (unsigned int ty = 0; ty < tilesY; ty++)
+	{
+		for (unsigned int tx = 0; tx < tilesX;)
+		{
+			if (!changed[ty * tilesX + tx])
+			{
+				tx++;
+				continue;
+			}
+
+			unsigned int tx1 = tx;
+
+			while (tx1 + 1 < tilesX && changed[ty * tilesX + tx1 + 1])
+			{
+				tx1++;
+			}
+
+			classifyTiles(frame, tx, ty, tx1, ty);
+
+			// The stored values of the tiles are the ones they got classified with
+			const unsigned int x0 = tx * tileSize;
+			const unsigned int x1 = std::min(width, (tx1 + 1) * tileSize);
+
+			cimg_forC(frame,c)
+			{
+				for (unsigned int y = ty * tileSize; y < std::min(height, (ty + 1) * tileSize); y++)
+				{
+					std::copy(frame.data(x0,y,0,c), frame.data(x0,y,0,c) + (x1 - x0), previousFrame.data(x0,y,0,c));
+				}
+			}
+
+			tx = tx1 + 1;
+		}
+	}
+
+	lastMask = rawMask;
+	this->postprocessMask(&lastMask);
+
+	return new CImg<bool>(lastMask);
+}
+
+template<typename T>
+void lime::VideoSegmentation<T>::classifyTiles( const CImg<T> &frame, unsigned int tx0, unsigned int ty0, unsigned int tx1, unsigned int ty1 )
+{
+	const Algorithm<T> &algorithm = *this->algorithm;
+	const int halo = algorithm.ApplyMedian() ? (int)(algorithm.MedianSize() / 2) : 0;
+
+	// The pixels within the median halo of the tiles get a different median as well
+	const int x0 = std::max(0, (int)(tx0 * tileSize) - halo);
+	const int y0 = std::max(0, (int)(ty0 * tileSize) - halo);
+	const int x1 = std::min(frame.width() - 1, (int)((tx1 + 1) * tileSize) - 1 + halo);
+	const int y1 = std::min(frame.height() - 1, (int)((ty1 + 1) * tileSize) - 1 + halo);
+
+	CImg<T> medianImg;
+	int offsetX = 0, offsetY = 0;
+
+	if (algorithm.ApplyMedian())
+	{
+		// Their median in turn depends on the pixels within the halo around them
+		offsetX = std::max(0, x0 - halo);
+		offsetY = std::max(0, y0 - halo);
+		medianImg = median::blurMedian(frame.get_crop(offsetX, offsetY, 0, 0, std::min(frame.width() - 1, x1 + halo), std::min(frame.height() - 1, y1 + halo), 0, frame.spectrum() - 1), algorithm.MedianSize());
+	}
+
+	const CImg<T> &src = algorithm.ApplyMedian() ? medianImg : frame;
+
+	for (int y = y0; y <= y1; y++)
+	{
+		this->classifyPixels(src.data(x0-offsetX,y-offsetY,0,0), src.data(x0-offsetX,y-offsetY,0,1), src.data(x0-offsetX,y-offsetY,0,2), x1 - x0 + 1, rawMask.data(x0,y,0,0));
+	}
+}
+
+template<typename T>
+bool lime::VideoSegmentation<T>::tileChanged( const CImg<T> &frame, unsigned int tx, unsigned int ty ) const
+{
+	const unsigned int x0 = tx * tileSize;
+	const unsigned int x1 = std::min((unsigned int)frame.width(), x0 + tileSize);
+	const unsigned int y0 = ty * tileSize;
+	const unsigned int y1 = std::min((unsigned int)frame.height(), y0 + tileSize);
+
+	cimg_forC(frame,c)
+	{
+		for (unsigned int y = y0; y < y1; y++)
+		{
+			const T *cur = frame.data(0,y,0,c);
+			const T *prev = previousFrame.data(0,y,0,c);
+
+			for (unsigned int x = x0; x < x1; x++)
+			{
+				if (std::fabs((double)cur[x] - (double)prev[x]) > tolerance)
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+} // end namespace lime
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file Workspace.hpp
+/// @brief Contains the Workspace class
+/// @date Oct 16, 2026 - First creation
+/// @package lime
+///
+
+#include <lime/util.hpp>
+#include <lime/BinaryMask.hpp>
+#include <lime/Median.hpp>
+#include <lime/Contour.hpp>
+#include <lime/DistanceTransform.hpp>
+#include <lime/RegionTable.hpp>
+#include <CImg.h>
+#include <vector>
+#include <cstddef>
+
+namespace lime
+{
+
+///
+/// @class Workspace
+///
+/// @version 0.3.0
+///
+/// @brief Owns the temporary buffers of the segmentation steps, so they are allocated once and reused for every image of the same size.
+///
+/// @details Every buffer is resized with assign / resize, which keeps the memory if the size does not change (or shrinks). After the first image
+/// of a size has been processed, further images of that size do not allocate memory in the steps that use the workspace. The buffers grow when a
+/// bigger image (or a mask with more regions) comes along and are only given back by release().
+///
+/// Every row band of the parallel steps has its own set of buffers, the other buffers are only used while a single thread works on the image.
+///
+/// @date Oct 16, 2026 - First creation
+/// @tparam T - The data type of the input images
+///
+template<typename T> class Workspace
+{
+
+public:
+
+	///
+	/// @brief The buffers of a single row band
+	///
+	struct Band
+	{
+		cimg_library::CImg<T> input; ///< The rows of the band (with the median halo) copied out of the image
+		cimg_library::CImg<T> filtered; ///< The median of input
+		std::vector<double> tileSums; ///< The color sums of the tiles of a tile row of the coarse-to-fine classification
+		cimg_library::CImg<T> shifted; ///< The mean colors of a tile row moved by the tolerance of the coarse-to-fine classification
+		cimg_library::CImg<bool> shiftedMask; ///< The classified colors of shifted
+		median::Buffers histograms; ///< The column histograms of the median filter
+		cimg_library::CImg<bool> mask; ///< The rows of the band (with the grow / shrink halo) of the bit mask
+		BinaryMask packed; ///< The packed mask of the grow / shrink algorithms of the band
+		std::vector<unsigned int> sizes; ///< The number of pixels of each local label
+		std::vector<unsigned int> lastPixels; ///< The last pixel of each local label
+		unsigned int regionCount; ///< The number of local labels
+		RegionTable regions; ///< The sums of the region statistics of each local label
+		double medianSeconds; ///< The time the median filter of the band took (only measured while statistics are recorded)
+		double classificationSeconds; ///< The time the classification of the band took (only measured while statistics are recorded)
+		unsigned long long evaluatedPixels; ///< The number of pixels the band classified
+
+		Band():regionCount(0),medianSeconds(0.0),classificationSeconds(0.0),evaluatedPixels(0){}
+
+		///
+		/// @brief Returns the number of bytes held by the buffers of the band
+		///
+		std::size_t footprint() const
+		{
+			return input.size() * sizeof(T) + filtered.size() * sizeof(T) + tileSums.capacity() * sizeof(double) + shifted.size() * sizeof(T) + shiftedMask.size() * sizeof(bool) + histograms.footprint() + mask.size() * sizeof(bool) + packed.footprint()
+				+ (sizes.capacity() + lastPixels.capacity()) * sizeof(unsigned int) + regions.footprint();
+		}
+	};
+
+	///
+	/// @brief Makes sure that there are buffers for count bands. Has to be called before the bands are processed in parallel.
+	///
+	void reserveBands(unsigned int count)
+	{
+		if (bands.size() < count)
+		{
+			bands.resize(count);
+		}
+	}
+
+	///
+	/// @brief Returns the buffers of a band (reserveBands has to be called first)
+	///
+	inline Band& band(unsigned int index) { return bands[index]; }
+
+	///
+	/// @brief Returns the packed mask that the grow / shrink algorithms use for the bit mask img.
+	/// @details The band masks have their own packed mask, because they are processed in parallel. All other masks share one.
+	///
+	BinaryMask& packedMask(const cimg_library::CImg<bool> *img)
+	{
+		for (std::size_t i = 0; i < bands.size(); i++)
+		{
+			if (&bands[i].mask == img)
+			{
+				return bands[i].packed;
+			}
+		}
+
+		return packed;
+	}
+
+	///
+	/// @brief Returns the number of bytes held by the workspace
+	///
+	std::size_t footprint() const
+	{
+		std::size_t bytes = maskCopy.size() * sizeof(bool) + visited.size() * sizeof(bool) + coarseColors.size() * sizeof(T) + (coarse.size() + uncertain.size() + tiles.size() + regionMask.size()) * sizeof(bool) + regions.capacity() * sizeof(Rect2D) + packed.footprint() + boundary.footprint() + contours.footprint() + distances.footprint()
+			+ (lastPixel.capacity() + offsets.capacity() + parent.capacity() + finalLabels.capacity() + regionStack.capacity()) * sizeof(unsigned int);
+
+		for (std::size_t i = 0; i < bands.size(); i++)
+		{
+			bytes += bands[i].footprint();
+		}
+
+		return bytes;
+	}
+
+	///
+	/// @brief Gives back all memory of the workspace
+	///
+	void release()
+	{
+		std::vector<Band>().swap(bands);
+		maskCopy.assign();
+		visited.assign();
+		coarseColors.assign();
+		coarse.assign();
+		uncertain.assign();
+		tiles.assign();
+		regionMask.assign();
+		std::vector<Rect2D>().swap(regions);
+		std::vector<unsigned int>().swap(regionStack);
+		packed.release();
+		boundary.release();
+		contours.labels.assign();
+		std::vector<unsigned int>().swap(contours.borders);
+		distances.columnDistances.assign();
+		std::vector<int>().swap(distances.envelopes);
+		std::vector<unsigned int>().swap(lastPixel);
+		std::vector<unsigned int>().swap(offsets);
+		std::vector<unsigned int>().swap(parent);
+		std::vector<unsigned int>().swap(finalLabels);
+	}
+
+	std::vector<Band> bands; ///< The buffers of the row bands
+
+	cimg_library::CImg<bool> maskCopy; ///< A copy of the bit mask (the unchanged source of the band-parallel grow / shrink algorithms, the mask of the seed detection and the distance map)
+	cimg_library::CImg<bool> visited; ///< The visited pixels of the single region seed detection and the visited values of a prior mask
+	cimg_library::CImg<T> coarseColors; ///< The coarse level of the coarse-to-fine classification (the mean color of every tile)
+	cimg_library::CImg<bool> coarse; ///< The classified mean colors of the coarse level
+	cimg_library::CImg<bool> uncertain; ///< The tiles whose mean color lies within the tolerance of the decision boundary
+	cimg_library::CImg<bool> tiles; ///< The tiles of the coarse-to-fine classification that are classified completely
+	cimg_library::CImg<bool> regionMask; ///< The mask of a region of interest together with its border context
+	std::vector<Rect2D> regions; ///< The regions of interest of a prior mask
+	std::vector<unsigned int> regionStack; ///< The flood fill stack of the regions of interest of a prior mask
+	BinaryMask packed; ///< The packed mask of all grow / shrink algorithms that do not run on a band, and of the seed detection
+	BinaryMask boundary; ///< The boundary pixels of the seed detection and the distance map
+	contour::Buffers contours; ///< The labels of the border following of the contour seed detection
+	distance::Buffers distances; ///< The column distances and envelopes of the distance map
+
+	std::vector<unsigned int> lastPixel; ///< The last pixel of each region of the labeling
+	std::vector<unsigned int> offsets; ///< The first provisional label of each band of the labeling
+	std::vector<unsigned int> parent; ///< The union-find forest of the provisional labels
+	std::vector<unsigned int> finalLabels; ///< The final label of each provisional label
+
+};
+
+} // end namespace lime
@@ -0,0 +1,523 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is part of lime, a lightweight C++ segmentation library          //
+//                                                                            //
+// Copyright (C) 2012 Alexandru Duliu                                         //
+//                                                                            //
+// lime is free software; you can redistribute it and/or                      //
+// modify it under the terms of the GNU Lesser General Public                 //
+// License as published by the Free Software Foundation; either               //
+// version 3 of the License, or (at your option) any later version.           //
+//                                                                            //
+// lime is distributed in the hope that it will be useful, but WITHOUT ANY    //
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS  //
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the //
+// GNU General Public License for more details.                               //
+//                                                                            //
+// You should have received a copy of the GNU Lesser General Public           //
+// License along with lime. If not, see <http://www.gnu.org/licenses/>.       //
+//                                                                            //
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+///
+/// @file simd.hpp
+/// @version 0.3.0
+/// @date Oct 16, 2026 - First creation
+/// @brief Vectorized classification kernels
+/// @details This file contains the SIMD kernels of the colorimetric algorithms. The instruction set is chosen at compile time (AVX2 if the compiler
+/// targets it, otherwise SSE2 on x86) and every kernel has a scalar fallback which produces exactly the same results.
+/// @package lime
+///
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define LIME_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LIME_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace lime
+{
+
+///
+/// @namespace lime::simd
+/// @brief Vectorized kernels that work on rows of planar 8-bit image data
+///
+namespace simd
+{
+
+///
+/// @brief Classifies a row of planar 8-bit RGB pixels with the YCbCr skin thresholds and writes the result into the bit mask.
+/// @details Cb and Cr are computed in 16-bit fixed point with the same formula as CImg::RGBtoYCbCr ((x + 128) >> 8 equals the truncated
+/// floating point result for 8-bit input), so the result is bit-exact to the scalar path. 32 (AVX2) or 16 (SSE2) pixels are processed per iteration.
+/// @param r The first channel of the row (R)
+/// @param g The second channel of the row (G)
+/// @param b The third channel of the row (B)
+/// @param count The number of pixels in the row
+/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+/// @param cbLower Smallest Cb value that is skin
+/// @param cbHigher Largest Cb value that is skin
+/// @param crLower Smallest Cr value that is skin
+/// @param crHigher Largest Cr value that is skin
+///
+inline void classifyYCbCrRow(const unsigned char *r, const unsigned char *g, const unsigned char *b, unsigned int count, bool *mask,
+	int16_t cbLower, int16_t cbHigher, int16_t crLower, int16_t crHigher)
+{
+	unsigned int i = 0;
+
+#if defined(LIME_SIMD_AVX2)
+
+	const __m256i cbLo = _mm256_set1_epi16(cbLower), cbHi = _mm256_set1_epi16(cbHigher);
+	const __m256i crLo = _mm256_set1_epi16(crLower), crHi = _mm256_set1_epi16(crHigher);
+	const __m256i c38 = _mm256_set1_epi16(38), c74 = _mm256_set1_epi16(74), c112 = _mm256_set1_epi16(112);
+	const __m256i c94 = _mm256_set1_epi16(94), c18 = _mm256_set1_epi16(18);
+	const __m256i c128 = _mm256_set1_epi16(128), one = _mm256_set1_epi8(1);
+
+	for (; i + 32 <= count; i += 32)
+	{
+		__m256i res[2];
+
+		for (int h = 0; h < 2; h++)
+		{
+			const __m256i R = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r + i + 16*h)));
+			const __m256i G = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(g + i + 16*h)));
+			const __m256i B = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(b + i + 16*h)));
+
+			// (-38*R - 74*G + 112*B + 128) >> 8 and (112*R - 94*G - 18*B + 128) >> 8, both fit into 16 bits for 8-bit input
+			__m256i cb = _mm256_add_epi16(_mm256_mullo_epi16(B,c112), c128);
+			cb = _mm256_sub_epi16(cb, _mm256_mullo_epi16(R,c38));
+			cb = _mm256_sub_epi16(cb, _mm256_mullo_epi16(G,c74));
+			cb = _mm256_add_epi16(_mm256_srai_epi16(cb,8), c128);
+
+			__m256i cr = _mm256_add_epi16(_mm256_mullo_epi16(R,c112), c128);
+			cr = _mm256_sub_epi16(cr, _mm256_mullo_epi16(G,c94));
+			cr = _mm256_sub_epi16(cr, _mm256_mullo_epi16(B,c18));
+			cr = _mm256_add_epi16(_mm256_srai_epi16(cr,8), c128);
+
+			// lower <= c <= higher  <=>  !(lower > c) && !(c > higher)
+			const __m256i outside = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpgt_epi16(cbLo,cb), _mm256_cmpgt_epi16(cb,cbHi)),
+				_mm256_or_si256(_mm256_cmpgt_epi16(crLo,cr), _mm256_cmpgt_epi16(cr,crHi)));
+
+			res[h] = outside;
+		}
+
+		// packs works per 128-bit lane, so the 64-bit blocks have to be put back into order
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(res[0],res[1]), 0xD8);
+		packed = _mm256_andnot_si256(packed, one);
+
+		_mm256_storeu_si256((__m256i*)(mask + i), packed);
+	}
+
+#elif defined(LIME_SIMD_SSE2)
+
+	const __m128i cbLo = _mm_set1_epi16(cbLower), cbHi = _mm_set1_epi16(cbHigher);
+	const __m128i crLo = _mm_set1_epi16(crLower), crHi = _mm_set1_epi16(crHigher);
+	const __m128i c38 = _mm_set1_epi16(38), c74 = _mm_set1_epi16(74), c112 = _mm_set1_epi16(112);
+	const __m128i c94 = _mm_set1_epi16(94), c18 = _mm_set1_epi16(18);
+	const __m128i c128 = _mm_set1_epi16(128), one = _mm_set1_epi8(1), zero = _mm_setzero_si128();
+
+	for (; i + 16 <= count; i += 16)
+	{
+		const __m128i r8 = _mm_loadu_si128((const __m128i*)(r + i));
+		const __m128i g8 = _mm_loadu_si128((const __m128i*)(g + i));
+		const __m128i b8 = _mm_loadu_si128((const __m128i*)(b + i));
+
+		__m128i res[2];
+
+		for (int h = 0; h < 2; h++)
+		{
+			const __m128i R = h ? _mm_unpackhi_epi8(r8,zero) : _mm_unpacklo_epi8(r8,zero);
+			const __m128i G = h ? _mm_unpackhi_epi8(g8,zero) : _mm_unpacklo_epi8(g8,zero);
+			const __m128i B = h ? _mm_unpackhi_epi8(b8,zero) : _mm_unpacklo_epi8(b8,zero);
+
+			// (-38*R - 74*G + 112*B + 128) >> 8 and (112*R - 94*G - 18*B + 128) >> 8, both fit into 16 bits for 8-bit input
+			__m128i cb = _mm_add_epi16(_mm_mullo_epi16(B,c112), c128);
+			cb = _mm_sub_epi16(cb, _mm_mullo_epi16(R,c38));
+			cb = _mm_sub_epi16(cb, _mm_mullo_epi16(G,c74));
+			cb = _mm_add_epi16(_mm_srai_epi16(cb,8), c128);
+
+			__m128i cr = _mm_add_epi16(_mm_mullo_epi16(R,c112), c128);
+			cr = _mm_sub_epi16(cr, _mm_mullo_epi16(G,c94));
+			cr = _mm_sub_epi16(cr, _mm_mullo_epi16(B,c18));
+			cr = _mm_add_epi16(_mm_srai_epi16(cr,8), c128);
+
+			// lower <= c <= higher  <=>  !(lower > c) && !(c > higher)
+			res[h] = _mm_or_si128(
+				_mm_or_si128(_mm_cmpgt_epi16(cbLo,cb), _mm_cmpgt_epi16(cb,cbHi)),
+				_mm_or_si128(_mm_cmpgt_epi16(crLo,cr), _mm_cmpgt_epi16(cr,crHi)));
+		}
+
+		_mm_storeu_si128((__m128i*)(mask + i), _mm_andnot_si128(_mm_packs_epi16(res[0],res[1]), one));
+	}
+
+#endif
+
+	// Scalar fallback for the remaining pixels (and for platforms without SIMD support)
+	for (; i < count; i++)
+	{
+		const int cb = ((-38*r[i] - 74*g[i] + 112*b[i] + 128) >> 8) + 128;
+		const int cr = ((112*r[i] - 94*g[i] - 18*b[i] + 128) >> 8) + 128;
+
+		mask[i] = (cbLower <= cb && cb <= cbHigher && crLower <= cr && cr <= crHigher);
+	}
+}
+
+#if defined(LIME_SIMD_AVX2) || defined(LIME_SIMD_SSE2)
+
+///
+/// @brief Single precision vector abstraction (8 lanes with AVX2, 4 lanes with SSE2) for the floating point kernels.
+/// Comparisons return a vector where the bits of every lane are either all set (true) or all cleared (false).
+///
+namespace vec
+{
+
+#if defined(LIME_SIMD_AVX2)
+
+	typedef __m256 Float;
+	static const unsigned int size = 8;
+
+	inline Float set(float v) { return _mm256_set1_ps(v); }
+	inline Float load(const unsigned char *p) { return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)p))); }
+	inline Float add(Float a, Float b) { return _mm256_add_ps(a,b); }
+	inline Float sub(Float a, Float b) { return _mm256_sub_ps(a,b); }
+	inline Float mul(Float a, Float b) { return _mm256_mul_ps(a,b); }
+	inline Float div(Float a, Float b) { return _mm256_div_ps(a,b); }
+	inline Float min(Float a, Float b) { return _mm256_min_ps(a,b); }
+	inline Float max(Float a, Float b) { return _mm256_max_ps(a,b); }
+	inline Float sqrt(Float a) { return _mm256_sqrt_ps(a); }
+	inline Float bitAnd(Float a, Float b) { return _mm256_and_ps(a,b); }
+	inline Float bitOr(Float a, Float b) { return _mm256_or_ps(a,b); }
+	inline Float bitAndNot(Float a, Float b) { return _mm256_andnot_ps(a,b); } ///< (~a) & b
+	inline Float bitNot(Float a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+	inline Float less(Float a, Float b) { return _mm256_cmp_ps(a,b,_CMP_LT_OQ); }
+	inline Float lessEqual(Float a, Float b) { return _mm256_cmp_ps(a,b,_CMP_LE_OQ); }
+	inline Float equal(Float a, Float b) { return _mm256_cmp_ps(a,b,_CMP_EQ_OQ); }
+	inline Float select(Float m, Float a, Float b) { return _mm256_blendv_ps(b,a,m); } ///< m ? a : b
+
+	/// @brief Writes one bool (0 or 1) for every lane of the comparison result m
+	inline void store(bool *p, Float m)
+	{
+		const __m256i i = _mm256_castps_si256(m);
+		const __m128i w = _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extracti128_si256(i,1));
+		_mm_storel_epi64((__m128i*)p, _mm_and_si128(_mm_packs_epi16(w,w), _mm_set1_epi8(1)));
+	}
+
+#else
+
+	typedef __m128 Float;
+	static const unsigned int size = 4;
+
+	inline Float set(float v) { return _mm_set1_ps(v); }
+	inline Float load(const unsigned char *p)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i b = _mm_cvtsi32_si128((int)p[0] | ((int)p[1] << 8) | ((int)p[2] << 16) | ((int)p[3] << 24));
+		return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(b,zero),zero));
+	}
+	inline Float add(Float a, Float b) { return _mm_add_ps(a,b); }
+	inline Float sub(Float a, Float b) { return _mm_sub_ps(a,b); }
+	inline Float mul(Float a, Float b) { return _mm_mul_ps(a,b); }
+	inline Float div(Float a, Float b) { return _mm_div_ps(a,b); }
+	inline Float min(Float a, Float b) { return _mm_min_ps(a,b); }
+	inline Float max(Float a, Float b) { return _mm_max_ps(a,b); }
+	inline Float sqrt(Float a) { return _mm_sqrt_ps(a); }
+	inline Float bitAnd(Float a, Float b) { return _mm_and_ps(a,b); }
+	inline Float bitOr(Float a, Float b) { return _mm_or_ps(a,b); }
+	inline Float bitAndNot(Float a, Float b) { return _mm_andnot_ps(a,b); } ///< (~a) & b
+	inline Float bitNot(Float a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+	inline Float less(Float a, Float b) { return _mm_cmplt_ps(a,b); }
+	inline Float lessEqual(Float a, Float b) { return _mm_cmple_ps(a,b); }
+	inline Float equal(Float a, Float b) { return _mm_cmpeq_ps(a,b); }
+	inline Float select(Float m, Float a, Float b) { return _mm_or_ps(_mm_and_ps(m,a), _mm_andnot_ps(m,b)); } ///< m ? a : b
+
+	/// @brief Writes one bool (0 or 1) for every lane of the comparison result m
+	inline void store(bool *p, Float m)
+	{
+		const __m128i w = _mm_packs_epi32(_mm_castps_si128(m), _mm_castps_si128(m));
+		const int bytes = _mm_cvtsi128_si32(_mm_and_si128(_mm_packs_epi16(w,w), _mm_set1_epi8(1)));
+		for (unsigned int k = 0; k < 4; k++)
+		{
+			p[k] = ((bytes >> (8*k)) & 1) != 0;
+		}
+	}
+
+#endif
+
+} // end namespace vec
+
+#endif
+
+///
+/// @struct HSVThresholds
+/// @brief The thresholds of ColorimetricHSVAlgorithm1 in single precision (S and V are expected in percent, H in degrees).
+///
+struct HSVThresholds
+{
+	float s_lower_1;
+	float v_lower_1;
+	float v_multiplier_1;
+	float v_addend_1;
+	float v_multiplier_2;
+	float v_addend_2;
+	float v_multiplier_3;
+	float v_addend_3;
+	float v_multiplier_4;
+	float h_multiplier_1;
+	float h_addend_1;
+};
+
+///
+/// @brief Classifies a row of planar 8-bit RGB pixels with the HSV skin thresholds and writes the result into the bit mask.
+/// @details Hue, saturation and value are computed in single precision like CImg::RGBtoHSV, and all inequalities of
+/// ColorimetricHSVAlgorithm1::skinThresholds are evaluated with masks, so there is no per-pixel branch. As the inequalities are evaluated
+/// in single precision the result can differ from the double precision path for colors which lie exactly on a threshold. With the default
+/// thresholds this happens for 7 of the 2^24 colors (test/accuracy.cpp allows at most 16).
+/// @param r The first channel of the row (R)
+/// @param g The second channel of the row (G)
+/// @param b The third channel of the row (B)
+/// @param count The number of pixels in the row
+/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+/// @param t The thresholds
+///
+inline void classifyHSVRow(const unsigned char *r, const unsigned char *g, const unsigned char *b, unsigned int count, bool *mask, const HSVThresholds &t)
+{
+	unsigned int i = 0;
+
+#if defined(LIME_SIMD_AVX2) || defined(LIME_SIMD_SSE2)
+
+	using namespace vec;
+
+	const Float c0 = set(0.0f), c1 = set(1.0f), c3 = set(3.0f), c5 = set(5.0f), c6 = set(6.0f), c60 = set(60.0f), c100 = set(100.0f), c255 = set(255.0f);
+
+	for (; i + size <= count; i += size)
+	{
+		const Float nR = div(load(r+i),c255);
+		const Float nG = div(load(g+i),c255);
+		const Float nB = div(load(b+i),c255);
+		const Float m = min(min(nR,nG),nB);
+		const Float M = max(max(nR,nG),nB);
+
+		// Hue and saturation are only defined for chromatic colors (M != m), otherwise they are 0
+		const Float chromatic = bitNot(equal(M,m));
+		const Float rMin = equal(nR,m);
+		const Float gMin = equal(nG,m);
+		const Float f = select(rMin, sub(nG,nB), select(gMin, sub(nB,nR), sub(nR,nG)));
+		const Float n = select(rMin, c3, select(gMin, c5, c1));
+
+		Float H = sub(n, div(f,sub(M,m)));
+		H = select(lessEqual(c6,H), sub(H,c6), H);
+		H = bitAnd(chromatic, mul(H,c60));
+
+		const Float S = mul(bitAnd(chromatic, div(sub(M,m),M)), c100);
+		const Float V = mul(M, c100);
+
+		// All inequalities that reject a pixel
+		Float reject = bitOr(less(S,set(t.s_lower_1)), less(V,set(t.v_lower_1)));
+		reject = bitOr(reject, less(add(sub(sub(c0,H), mul(set(t.v_multiplier_1),V)), set(t.v_addend_1)), S));
+		reject = bitOr(reject, less(add(mul(set(t.v_multiplier_2),V), set(t.v_addend_2)), H));
+
+		const Float positiveHue = lessEqual(c0,H);
+		const Float rejectPositive = less(add(mul(mul(set(t.v_multiplier_3), sub(set(t.v_addend_3),V)), H), mul(set(t.v_multiplier_4),V)), S);
+		const Float rejectNegative = less(add(mul(set(t.h_multiplier_1),H), set(t.h_addend_1)), S);
+		reject = bitOr(reject, select(positiveHue, rejectPositive, rejectNegative));
+
+		store(mask+i, bitNot(reject));
+	}
+
+#endif
+
+	// Scalar fallback for the remaining pixels (and for platforms without SIMD support)
+	for (; i < count; i++)
+	{
+		const float nR = r[i]/255.0f;
+		const float nG = g[i]/255.0f;
+		const float nB = b[i]/255.0f;
+		const float m = std::min(std::min(nR,nG),nB);
+		const float M = std::max(std::max(nR,nG),nB);
+
+		float H = 0, S = 0;
+
+		if (M != m)
+		{
+			const float f = (nR==m)?(nG-nB):((nG==m)?(nB-nR):(nR-nG));
+			const float n = (nR==m)?3.0f:((nG==m)?5.0f:1.0f);
+
+			H = n - f/(M-m);
+			H = (6.0f <= H) ? H - 6.0f : H;
+			H *= 60.0f;
+			S = (M-m)/M;
+		}
+
+		S *= 100.0f;
+		const float V = M*100.0f;
+
+		const bool rejectPositive = (t.v_multiplier_3*(t.v_addend_3 - V))*H + t.v_multiplier_4*V < S;
+		const bool rejectNegative = t.h_multiplier_1*H + t.h_addend_1 < S;
+
+		mask[i] = !((S < t.s_lower_1) | (V < t.v_lower_1) | (((0.0f - H) - t.v_multiplier_1*V) + t.v_addend_1 < S) |
+			(t.v_multiplier_2*V + t.v_addend_2 < H) | ((0.0f <= H) ? rejectPositive : rejectNegative));
+	}
+}
+
+///
+/// @struct HSIThresholds
+/// @brief The thresholds of ColorimetricHSIAlgorithm1 in single precision (H in degrees, S and I in [0,1]).
+///
+struct HSIThresholds
+{
+	float h_lower_1;
+	float h_higher_1;
+	float h_lower_2;
+	float h_higher_2;
+	float h_lower_3;
+	float h_higher_3;
+	float i_lower;
+	float s_lower;
+	float s_higher_1;
+	float s_higher_2;
+};
+
+///
+/// @brief Polynomial approximation of acos(|x|) for |x| <= 1 (Abramowitz and Stegun 4.4.46, absolute error below 2e-8 radians).
+///
+inline float acosPolynomial(float x)
+{
+	return std::sqrt(1.0f - x) * (1.5707963050f + x*(-0.2145988016f + x*(0.0889789874f + x*(-0.0501743046f + x*(0.0308918810f +
+		x*(-0.0170881256f + x*(0.0066700901f + x*-0.0012624911f)))))));
+}
+
+#if defined(LIME_SIMD_AVX2) || defined(LIME_SIMD_SSE2)
+
+///
+/// @brief Vectorized version of acosPolynomial for x in [0,1].
+///
+inline vec::Float acosPolynomial(vec::Float x)
+{
+	using namespace vec;
+
+	Float p = set(-0.0012624911f);
+	p = add(mul(p,x), set(0.0066700901f));
+	p = add(mul(p,x), set(-0.0170881256f));
+	p = add(mul(p,x), set(0.0308918810f));
+	p = add(mul(p,x), set(-0.0501743046f));
+	p = add(mul(p,x), set(0.0889789874f));
+	p = add(mul(p,x), set(-0.2145988016f));
+	p = add(mul(p,x), set(1.5707963050f));
+
+	return mul(sqrt(sub(set(1.0f),x)), p);
+}
+
+#endif
+
+///
+/// @brief Classifies a row of planar 8-bit RGB pixels with the HSI skin thresholds and writes the result into the bit mask.
+/// @details Instead of std::acos and double precision (CImg::RGBtoHSI) the hue is computed in single precision with a polynomial approximation
+/// of acos, which keeps the hue error below 0.002 degrees. All thresholds are evaluated with masks, so there is no per-pixel branch. Colors
+/// which lie exactly on a threshold can be classified differently than by the double precision path. With the default thresholds none of the
+/// 2^24 colors is (test/accuracy.cpp allows at most 16).
+/// @param r The first channel of the row (R)
+/// @param g The second channel of the row (G)
+/// @param b The third channel of the row (B)
+/// @param count The number of pixels in the row
+/// @param mask The row of the bit mask that receives the result (true = skin, false = no skin)
+/// @param t The thresholds
+///
+inline void classifyHSIRow(const unsigned char *r, const unsigned char *g, const unsigned char *b, unsigned int count, bool *mask, const HSIThresholds &t)
+{
+	// ColorimetricHSIAlgorithm1::skinThresholds only tests the threshold s_lower for being non-zero in its first saturation condition
+	const bool sLowerSet = (t.s_lower != 0);
+
+	unsigned int i = 0;
+
+#if defined(LIME_SIMD_AVX2) || defined(LIME_SIMD_SSE2)
+
+	using namespace vec;
+
+	const Float c0 = set(0.0f), c1 = set(1.0f), c3 = set(3.0f), c360 = set(360.0f), c255 = set(255.0f);
+	const Float degrees = set(57.2957795f), half = set(0.5f), signMask = set(-0.0f);
+	const Float lowerSet = sLowerSet ? bitNot(c0) : c0;
+
+	for (; i + size <= count; i += size)
+	{
+		const Float nR = div(load(r+i),c255);
+		const Float nG = div(load(g+i),c255);
+		const Float nB = div(load(b+i),c255);
+		const Float m = min(min(nR,nG),nB);
+		const Float sum = add(add(nR,nG),nB);
+
+		// theta = acos(num/den), for den == 0 (gray) the hue is 0
+		const Float num = mul(half, add(sub(nR,nG), sub(nR,nB)));
+		const Float den = sqrt(add(mul(sub(nR,nG),sub(nR,nG)), mul(sub(nR,nB),sub(nG,nB))));
+		const Float valid = less(c0,den);
+		const Float x = min(div(num,den), c1);
+		const Float ax = min(bitAndNot(signMask,x), c1);
+		const Float acosAbs = acosPolynomial(ax);
+		Float theta = mul(select(less(x,c0), sub(set(3.14159265f),acosAbs), acosAbs), degrees);
+		theta = bitAnd(valid, theta);
+
+		const Float H = bitAnd(less(c0,theta), select(lessEqual(nB,nG), theta, sub(c360,theta)));
+		const Float S = bitAnd(less(c0,sum), sub(c1, mul(div(c3,sum),m)));
+		const Float I = div(sum,c3);
+
+		const Float hue3 = bitAnd(less(set(t.h_lower_3),H), less(H,set(t.h_higher_3)));
+		const Float hue12 = bitOr(bitAnd(less(set(t.h_lower_1),H), less(H,set(t.h_higher_1))),
+			bitAnd(less(set(t.h_lower_2),H), less(H,set(t.h_higher_2))));
+
+		const Float lowSaturation = bitAnd(lowerSet, less(S,set(t.s_higher_2)));
+		const Float midSaturation = bitAnd(less(set(t.s_lower),S), less(S,set(t.s_higher_1)));
+
+		const Float skin = bitAndNot(less(I,set(t.i_lower)), select(lowSaturation, hue3, bitAnd(midSaturation, hue12)));
+
+		store(mask+i, skin);
+	}
+
+#endif
+
+	// Scalar fallback for the remaining pixels (and for platforms without SIMD support)
+	for (; i < count; i++)
+	{
+		const float nR = r[i]/255.0f;
+		const float nG = g[i]/255.0f;
+		const float nB = b[i]/255.0f;
+		const float m = std::min(std::min(nR,nG),nB);
+		const float sum = (nR + nG) + nB;
+
+		const float num = 0.5f*((nR-nG) + (nR-nB));
+		const float den = std::sqrt((nR-nG)*(nR-nG) + (nR-nB)*(nG-nB));
+
+		float theta = 0;
+
+		if (den > 0)
+		{
+			const float x = std::min(num/den, 1.0f);
+			const float acosAbs = acosPolynomial(std::min(std::fabs(x), 1.0f));
+
+			theta = ((x < 0) ? 3.14159265f - acosAbs : acosAbs) * 57.2957795f;
+		}
+
+		const float H = (theta > 0) ? ((nB <= nG) ? theta : 360.0f - theta) : 0.0f;
+		const float S = (sum > 0) ? 1.0f - (3.0f/sum)*m : 0.0f;
+		const float I = sum/3.0f;
+
+		const bool hue3 = (t.h_lower_3 < H) & (H < t.h_higher_3);
+		const bool hue12 = ((t.h_lower_1 < H) & (H < t.h_higher_1)) | ((t.h_lower_2 < H) & (H < t.h_higher_2));
+
+		const bool lowSaturation = sLowerSet & (S < t.s_higher_2);
+		const bool midSaturation = (t.s_lower < S) & (S < t.s_higher_1);
+
+		mask[i] = !(I < t.i_lower) && (lowSaturation ? hue3 : (midSaturation & hue12));
+	}
+}
+
+} // end namespace simd
+
+} // end namespace lime
@@ -27,17 +27,22 @@
 /// @author Alexandru Duliu, Alexander Schoch
 /// @version 0.3.0
 /// @date Oct 29, 2012 - First creation
+/// @date Oct 16, 2026 - ImageView for image data that is not stored in a CImg
+/// @date Oct 16, 2026 - Rect2D for regions of interest and getRegionsOfInterest for prior masks
 /// @brief Collection of utility functions
 /// @details This file contains a collection of small utility functions to simplify development of the lime library.
 /// @package lime
 ///
 
 #include <cmath>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <queue>
+#include <cstddef>
 #include <stdint.h>
 #include <exception>
+#include <stdexcept>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
@@ -77,6 +82,223 @@ namespace lime
 		unsigned int y;
 	};
 
+	///
+	/// @struct Rect2D
+	/// @brief This struct describes an axis-aligned rectangle of pixels in Cartesian space (e.g. a region of interest found by a detector).
+	/// @details The rectangle covers the columns [x,x+width) and the rows [y,y+height). It may reach outside of the image, it is clipped where it is used.
+	///
+	struct Rect2D
+	{
+	public:
+
+		Rect2D():x(0),y(0),width(0),height(0){}
+		Rect2D(int _x, int _y, int _width, int _height):x(_x),y(_y),width(_width),height(_height){}
+
+		///
+		/// @brief Returns true if the rectangle contains no pixel
+		///
+		inline bool empty() const { return width <= 0 || height <= 0; }
+
+		///
+		/// @brief Returns the rectangle grown by margin pixels on every side
+		///
+		inline Rect2D expanded(int margin) const { return Rect2D(x - margin, y - margin, width + 2 * margin, height + 2 * margin); }
+
+		///
+		/// @brief Returns the part of the rectangle that lies inside an image with the given width and height (empty if there is none)
+		///
+		inline Rect2D clipped(int _width, int _height) const
+		{
+			const int x0 = std::max(x, 0);
+			const int y0 = std::max(y, 0);
+			const int x1 = std::min(x + width, _width);
+			const int y1 = std::min(y + height, _height);
+
+			return Rect2D(x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0));
+		}
+
+		int x;
+		int y;
+		int width;
+		int height;
+	};
+
+	///
+	/// @enum ChannelOrder
+	/// @brief Order of the color channels of the pixels of an ImageView
+	///
+	enum ChannelOrder
+	{
+		ChannelOrderRGB,	///< Red, green, blue
+		ChannelOrderBGR,	///< Blue, green, red
+		ChannelOrderRGBA,	///< Red, green, blue, alpha
+		ChannelOrderBGRA,	///< Blue, green, red, alpha
+		ChannelOrderARGB,	///< Alpha, red, green, blue
+		ChannelOrderABGR	///< Alpha, blue, green, red
+	};
+
+	///
+	/// @brief Throws a CImgArgumentException if an image has less than the 3 channels of RGB data that the algorithms read
+	/// @param channels The number of channels of the image
+	/// @param function The name of the function that received the image (used in the message)
+	///
+	inline void checkChannels(unsigned int channels, const char *function)
+	{
+		if (channels < 3)
+		{
+			throw cimg_library::CImgArgumentException("%s : The image has %u channel(s), but RGB data with 3 channels is needed.", function, channels);
+		}
+	}
+
+	///
+	/// @struct ImageView
+	/// @brief This struct describes image data that is owned by someone else (e.g. the buffer of a camera), so it can be segmented without converting it into a CImg.
+	/// @details The value of channel c of pixel (x,y) is stored at data[y*rowStride + x*pixelStep() + channelOffset(c)], where channelOffset(c) is
+	/// a multiple of planeStride for planar data. All strides are given in elements of type T, not in bytes.
+	/// @tparam T The data format of each image channel (e.g. char or double)
+	///
+	template<typename T> struct ImageView
+	{
+	public:
+
+		ImageView():data(0),width(0),height(0),rowStride(0),planeStride(0),order(ChannelOrderRGB),planar(false){}
+
+		///
+		/// @brief Creates a view of the first slice of a CImg (planar, RGB). Throws a CImgArgumentException if the image has less than 3 channels.
+		///
+		explicit ImageView(const cimg_library::CImg<T> &img):data(img.data()),width(img.width()),height(img.height()),rowStride(img.width()),
+			planeStride((std::size_t)img.width() * img.height() * img.depth()),order(ChannelOrderRGB),planar(true)
+		{
+			checkChannels(img.spectrum(), "lime::ImageView()");
+		}
+
+		///
+		/// @brief Creates a view of interleaved data (all channels of a pixel next to each other)
+		/// @param _data The first channel of the first pixel
+		/// @param _width The number of pixels of a row
+		/// @param _height The number of rows
+		/// @param _order The order of the channels of a pixel
+		/// @param _rowStride The number of elements between the starts of two rows (0 = rows without padding)
+		///
+		static ImageView interleaved(const T *_data, unsigned int _width, unsigned int _height, ChannelOrder _order = ChannelOrderRGB, std::size_t _rowStride = 0)
+		{
+			ImageView view;
+			view.data = _data;
+			view.width = _width;
+			view.height = _height;
+			view.order = _order;
+			view.planar = false;
+			view.rowStride = _rowStride ? _rowStride : (std::size_t)_width * view.channels();
+			return view;
+		}
+
+		///
+		/// @brief Creates a view of planar data (one plane per channel)
+		/// @param _data The first value of the first plane
+		/// @param _width The number of pixels of a row
+		/// @param _height The number of rows
+		/// @param _order The order of the planes
+		/// @param _rowStride The number of elements between the starts of two rows (0 = rows without padding)
+		/// @param _planeStride The number of elements between the starts of two planes (0 = planes without padding)
+		///
+		static ImageView planarView(const T *_data, unsigned int _width, unsigned int _height, ChannelOrder _order = ChannelOrderRGB, std::size_t _rowStride = 0, std::size_t _planeStride = 0)
+		{
+			ImageView view;
+			view.data = _data;
+			view.width = _width;
+			view.height = _height;
+			view.order = _order;
+			view.planar = true;
+			view.rowStride = _rowStride ? _rowStride : _width;
+			view.planeStride = _planeStride ? _planeStride : view.rowStride * _height;
+			return view;
+		}
+
+		///
+		/// @brief Returns the number of channels of a pixel (3 or 4)
+		///
+		inline unsigned int channels() const { return (order == ChannelOrderRGB || order == ChannelOrderBGR) ? 3 : 4; }
+
+		///
+		/// @brief Returns the number of elements between two pixels of the same channel in a row
+		///
+		inline unsigned int pixelStep() const { return planar ? 1 : channels(); }
+
+		///
+		/// @brief Returns the position of a channel in a pixel (planar: the index of the plane)
+		/// @param c The channel (0 = red, 1 = green, 2 = blue)
+		///
+		inline unsigned int channelIndex(unsigned int c) const
+		{
+			static const unsigned char index[6][3] = { {0,1,2}, {2,1,0}, {0,1,2}, {2,1,0}, {1,2,3}, {3,2,1} };
+			return index[order][c];
+		}
+
+		///
+		/// @brief Returns the first value of channel c in row y
+		/// @param c The channel (0 = red, 1 = green, 2 = blue)
+		/// @param y The row
+		///
+		inline const T* row(unsigned int c, unsigned int y) const
+		{
+			return data + (std::size_t)y * rowStride + (planar ? channelIndex(c) * planeStride : channelIndex(c));
+		}
+
+		///
+		/// @brief Returns a view of a part of the image without copying the data
+		/// @param rect The part of the image (has to lie inside of the image)
+		///
+		ImageView crop(const Rect2D &rect) const
+		{
+			ImageView view(*this);
+			view.data = data + (std::size_t)rect.y * rowStride + (std::size_t)rect.x * pixelStep();
+			view.width = rect.width;
+			view.height = rect.height;
+			return view;
+		}
+
+		///
+		/// @brief Copies the rows [y0,y1) into a planar RGB image
+		///
+		cimg_library::CImg<T> getRows(unsigned int y0, unsigned int y1) const
+		{
+			cimg_library::CImg<T> img;
+			getRows(y0, y1, img);
+			return img;
+		}
+
+		///
+		/// @brief Copies the rows [y0,y1) into a planar RGB image (its memory is reused if it already has the right size)
+		///
+		void getRows(unsigned int y0, unsigned int y1, cimg_library::CImg<T> &img) const
+		{
+			img.assign(width, y1 - y0, 1, 3);
+			const unsigned int step = pixelStep();
+
+			for (unsigned int c = 0; c < 3; c++)
+			{
+				for (unsigned int y = y0; y < y1; y++)
+				{
+					const T *src = row(c, y);
+					T *dst = img.data(0, y - y0, 0, c);
+
+					for (unsigned int x = 0; x < width; x++)
+					{
+						dst[x] = src[(std::size_t)x * step];
+					}
+				}
+			}
+		}
+
+		const T *data;			///< The first element of the image
+		unsigned int width;		///< The number of pixels of a row
+		unsigned int height;	///< The number of rows
+		std::size_t rowStride;	///< The number of elements between the starts of two rows
+		std::size_t planeStride;	///< The number of elements between the starts of two planes (only planar data)
+		ChannelOrder order;		///< The order of the channels
+		bool planar;			///< True if every channel is stored in its own plane, false if the channels of a pixel are next to each other
+	};
+
 ///
 /// @brief This function can be used to load an image from a file into a CImg object using the filepath
 /// @param filename The path of the image that should be loaded
@@ -228,11 +450,11 @@ inline void fuseBinaryMaskWithRGBImage(cimg_library::CImg<T> *img, cimg_library:
 
 	if (imgWidth != mask->width() || imgHeight != mask->height())
 	{
-		throw std::exception("Dimensions of mask and image don't match!");
+		throw std::runtime_error("Dimensions of mask and image don't match!");
 	}
 
 	// Copy the image data over into a temporary container
-	CImg<T> tempImg(*img);
+	cimg_library::CImg<T> tempImg(*img);
 
 	// Changes the image in-place to an image with 4 channels
 	img->assign(imgWidth,imgHeight,1,4);
@@ -257,6 +479,99 @@ inline void fuseBinaryMaskWithRGBImage(cimg_library::CImg<T> *img, cimg_library:
 	}
 }
 
+///
+/// @brief Finds the regions of interest of a prior mask: the bounding rectangles of its 8-connected regions, scaled to an image of the given size.
+/// @details The prior mask can be coarser than the image (e.g. one value per block of a detector grid). Pixel (x,y) of the image belongs to the value
+/// (x*priorWidth/width, y*priorHeight/height) of the prior mask.
+/// @param prior The prior mask (true = skin can be present, false = no skin)
+/// @param width The width of the image
+/// @param height The height of the image
+/// @param regions Receives the rectangles (its memory is reused)
+/// @param visited Buffer for the visited values of the prior mask (its memory is reused)
+/// @param stack Buffer for the flood fill (its memory is reused)
+///
+inline void getRegionsOfInterest(const cimg_library::CImg<bool> &prior, int width, int height, std::vector<Rect2D> &regions,
+	cimg_library::CImg<bool> &visited, std::vector<unsigned int> &stack)
+{
+	const int priorWidth = prior.width();
+	const int priorHeight = prior.height();
+
+	regions.clear();
+	visited.assign(priorWidth, priorHeight, 1, 1);
+	visited.fill(false);
+
+	for (int py = 0; py < priorHeight; py++)
+	{
+		for (int px = 0; px < priorWidth; px++)
+		{
+			if (!prior(px,py) || visited(px,py))
+			{
+				continue;
+			}
+
+			// Flood fill of the region of (px,py), which only keeps its bounding box
+			int minX = px, maxX = px, minY = py, maxY = py;
+
+			visited(px,py) = true;
+			stack.clear();
+			stack.push_back((unsigned int)(py * priorWidth + px));
+
+			while (!stack.empty())
+			{
+				const int x = (int)(stack.back() % priorWidth);
+				const int y = (int)(stack.back() / priorWidth);
+				stack.pop_back();
+
+				minX = std::min(minX, x);
+				maxX = std::max(maxX, x);
+				minY = std::min(minY, y);
+				maxY = std::max(maxY, y);
+
+				for (int ny = std::max(0, y - 1); ny <= std::min(priorHeight - 1, y + 1); ny++)
+				{
+					for (int nx = std::max(0, x - 1); nx <= std::min(priorWidth - 1, x + 1); nx++)
+					{
+						if (prior(nx,ny) && !visited(nx,ny))
+						{
+							visited(nx,ny) = true;
+							stack.push_back((unsigned int)(ny * priorWidth + nx));
+						}
+					}
+				}
+			}
+
+			// The first pixel that belongs to value v of the prior mask is ceil(v*width/priorWidth)
+			const int x0 = (int)(((long long)minX * width + priorWidth - 1) / priorWidth);
+			const int x1 = (int)(((long long)(maxX + 1) * width + priorWidth - 1) / priorWidth);
+			const int y0 = (int)(((long long)minY * height + priorHeight - 1) / priorHeight);
+			const int y1 = (int)(((long long)(maxY + 1) * height + priorHeight - 1) / priorHeight);
+
+			if (x1 > x0 && y1 > y0)
+			{
+				regions.push_back(Rect2D(x0, y0, x1 - x0, y1 - y0));
+			}
+		}
+	}
+}
+
+///
+/// @brief Finds the regions of interest of a prior mask: the bounding rectangles of its 8-connected regions, scaled to an image of the given size.
+/// @param prior The prior mask (true = skin can be present, false = no skin)
+/// @param width The width of the image
+/// @param height The height of the image
+/// @return The rectangles of the regions
+///
+inline std::vector<Rect2D> getRegionsOfInterest(const cimg_library::CImg<bool> &prior, int width, int height)
+{
+	std::vector<Rect2D> regions;
+	cimg_library::CImg<bool> visited;
+	std::vector<unsigned int> stack;
+
+	getRegionsOfInterest(prior, width, height, regions, visited, stack);
+
+	return regions;
+}
+
 } // end namespace lime
 
 
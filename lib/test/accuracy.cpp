@@ -0,0 +1,98 @@
+#include <iostream>
+#include <vector>
+#include <lime/ColorimetricHSVAlgorithm1.hpp>
+#include <lime/ColorimetricHSIAlgorithm1.hpp>
+
+using namespace lime;
+
+// Counts the colors that the single precision SIMD kernels (ApplyVectorization) classify differently than the double precision path. The
+// kernels may only disagree for colors that lie (almost) exactly on a threshold, the test fails if more colors than the documented bound differ.
+
+// Exit code that tells CTest that the test was skipped
+static const int skipped = 77;
+
+// Gives access to the classification steps of an algorithm
+template<class A>
+class AccuracyTest : public A
+{
+public:
+
+	bool classifyPixel(unsigned char r, unsigned char g, unsigned char b)
+	{
+		double c1,c2,c3;
+		this->transformPixel(r,g,b,c1,c2,c3);
+
+		return this->skinThresholds(c1,c2,c3);
+	}
+
+	void classify(const unsigned char *r, const unsigned char *g, const unsigned char *b, unsigned int count, bool *mask)
+	{
+		this->classifyRow(r,g,b,count,mask);
+	}
+};
+
+// Classifies all 2^24 colors (one row of 256 blue values per red and green value) with the vectorized and the double precision path and
+// returns the number of colors with different results
+template<class A>
+unsigned int countDifferences()
+{
+	AccuracyTest<A> algo;
+	algo.ApplyVectorization(true);
+
+	std::vector<unsigned char> r(256), g(256), b(256);
+	bool mask[256];
+	unsigned int differences = 0;
+
+	for (int i = 0; i < 256; i++)
+	{
+		b[i] = (unsigned char)i;
+	}
+
+	for (int red = 0; red < 256; red++)
+	{
+		for (int green = 0; green < 256; green++)
+		{
+			std::fill(r.begin(), r.end(), (unsigned char)red);
+			std::fill(g.begin(), g.end(), (unsigned char)green);
+
+			algo.classify(r.data(), g.data(), b.data(), 256, mask);
+
+			for (int blue = 0; blue < 256; blue++)
+			{
+				differences += (mask[blue] != algo.classifyPixel((unsigned char)red, (unsigned char)green, (unsigned char)blue)) ? 1 : 0;
+			}
+		}
+	}
+
+	return differences;
+}
+
+// Compares the number of differences with its upper bound and returns true if it is not exceeded
+bool check(const char *name, unsigned int differences, unsigned int bound)
+{
+	std::cout << name << ": " << differences << " of 2^24 colors differ (at most " << bound << " allowed)" << std::endl;
+
+	return differences <= bound;
+}
+
+int main(int argc, char** argv)
+{
+#if defined(LIME_SIMD_AVX2) && defined(__GNUC__)
+	if (!__builtin_cpu_supports("avx2"))
+	{
+		std::cout << "AVX2 is not supported by this CPU, skipped" << std::endl;
+		return skipped;
+	}
+#endif
+
+	// Upper bounds of the differences with the default thresholds (documented at the kernels in simd.hpp). HSV: 7 colors differ because the
+	// kernel computes hue, saturation and value and evaluates the inequalities in single precision. HSI: no color differs, although the kernel
+	// approximates acos with a polynomial.
+	const unsigned int hsvBound = 16;
+	const unsigned int hsiBound = 16;
+
+	bool ok = check("HSV", countDifferences< ColorimetricHSVAlgorithm1<unsigned char> >(), hsvBound);
+	ok = check("HSI", countDifferences< ColorimetricHSIAlgorithm1<unsigned char> >(), hsiBound) && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <vector>
+#include <lime/Segmentation.hpp>
+#include <lime/VideoSegmentation.hpp>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <lime/ColorimetricHSVAlgorithm1.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+// Checks that images with less than 3 channels are rejected with a CImgArgumentException instead of being read past their end, and that
+// images with 3 or more channels are still accepted.
+
+// Runs every entry point that takes a CImg on an image with the given number of channels and returns the number of entry points that did not
+// behave as expected (throw for less than 3 channels, no exception otherwise)
+template<class A, typename T>
+unsigned int testChannels(const char *name, unsigned int channels)
+{
+	const bool valid = channels >= 3;
+	const CImg<T> img(64,64,1,channels,(T)100);
+	const std::vector<Rect2D> regions(1, Rect2D(8,8,16,16));
+
+	unsigned int failures = 0;
+
+	for (unsigned int entry = 0; entry < 6; entry++)
+	{
+		A algo;
+		algo.ApplyVectorization(true);
+		Segmentation<T> segm(&algo);
+		VideoSegmentation<T> video(&algo);
+		CImg<bool> mask;
+		std::vector< CImg<bool> > masks;
+		bool thrown = false;
+
+		try
+		{
+			switch (entry)
+			{
+			case 0: segm.retrieveMask_asBinaryChannel(img,mask); break;
+			case 1: segm.retrieveMask_ofRegions(img,regions,mask); break;
+			case 2: segm.retrieveMask_ofRegions(img,regions,masks); break;
+			case 3: delete video.retrieveMask_ofFrame(img); break;
+			case 4: segm.retrieveMask_asBinaryChannel(ImageView<T>(img),mask); break;
+			case 5: segm.retrieveMask_ofRegions(img,CImg<bool>(8,8,1,1,true),mask); break;
+			}
+		}
+		catch (CImgArgumentException&)
+		{
+			thrown = true;
+		}
+
+		if (thrown == valid)
+		{
+			std::cout << name << " with " << channels << " channel(s): entry point " << entry << (thrown ? " threw" : " did not throw") << std::endl;
+			failures++;
+		}
+	}
+
+	return failures;
+}
+
+int main(int argc, char** argv)
+{
+	// The exceptions are expected, CImg should not print them
+	cimg::exception_mode(0);
+
+	unsigned int failures = 0;
+
+	for (unsigned int channels = 1; channels <= 4; channels++)
+	{
+		failures += testChannels< ColorimetricYCbCrAlgorithm1<unsigned char>, unsigned char >("YCbCr unsigned char", channels);
+		failures += testChannels< ColorimetricHSVAlgorithm1<unsigned char>, unsigned char >("HSV unsigned char", channels);
+		failures += testChannels< ColorimetricYCbCrAlgorithm1<float>, float >("YCbCr float", channels);
+	}
+
+	std::cout << failures << " entry points behaved wrongly" << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
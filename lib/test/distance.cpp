@@ -0,0 +1,123 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <lime/Segmentation.hpp>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+// Compares the distance map of getDistanceMapOfMask with a brute-force search: the squared Euclidean distance to the nearest contour pixel
+// (a skin pixel with a non-skin pixel among its 8 neighbors, the image is continued by repeating its border), negated for skin pixels and 0
+// everywhere if there is no contour pixel.
+
+// Returns the distance map of the mask computed by comparing every pixel with every contour pixel
+CImg<int> bruteForce(const CImg<bool> &mask)
+{
+	const int width = mask.width(), height = mask.height();
+	std::vector<int> contourX, contourY;
+
+	cimg_forXY(mask,x,y)
+	{
+		bool contour = false;
+
+		for (int dy = -1; dy <= 1 && mask(x,y); dy++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+			{
+				const int nx = std::min(width - 1, std::max(0, x + dx)), ny = std::min(height - 1, std::max(0, y + dy));
+				contour = contour || !mask(nx,ny);
+			}
+		}
+
+		if (contour)
+		{
+			contourX.push_back(x);
+			contourY.push_back(y);
+		}
+	}
+
+	CImg<int> distances(width,height,1,1,0);
+
+	if (contourX.empty())
+	{
+		return distances;
+	}
+
+	cimg_forXY(mask,x,y)
+	{
+		int best = -1;
+
+		for (std::size_t i = 0; i < contourX.size(); i++)
+		{
+			const int d = (x - contourX[i]) * (x - contourX[i]) + (y - contourY[i]) * (y - contourY[i]);
+			best = (best < 0 || d < best) ? d : best;
+		}
+
+		distances(x,y) = mask(x,y) ? -best : best;
+	}
+
+	return distances;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failures = 0;
+	const unsigned int masks = 400;
+
+	srand(1);
+
+	for (unsigned int m = 0; m < masks; m++)
+	{
+		const int width = 1 + rand() % 50, height = 1 + rand() % 50;
+		CImg<bool> mask(width,height,1,1,false);
+
+		if (m % 2)
+		{
+			// Noise of every density
+			const int density = rand() % 100;
+
+			cimg_forXY(mask,x,y)
+			{
+				mask(x,y) = (rand() % 100) < density;
+			}
+		}
+		else
+		{
+			// A few discs, so there are pixels far away from the contours
+			for (int k = 0; k < 3; k++)
+			{
+				const int cx = rand() % width, cy = rand() % height, r = 1 + rand() % 15;
+
+				cimg_forXY(mask,x,y)
+				{
+					mask(x,y) = mask(x,y) || (x - cx) * (x - cx) + (y - cy) * (y - cy) < r * r;
+				}
+			}
+		}
+
+		const CImg<int> expected = bruteForce(mask);
+
+		// The serial transform and the transform of parallel row and column bands
+		for (unsigned int threads = 1; threads <= 3; threads += 2)
+		{
+			ColorimetricYCbCrAlgorithm1<unsigned char> algo;
+			algo.ThreadCount(threads);
+			Segmentation<unsigned char> segm(&algo);
+
+			CImg<int> *distances = segm.retrieveDistanceMapOfMask(mask);
+
+			if (*distances != expected)
+			{
+				std::cout << "mask " << m << " (" << width << "x" << height << ") with " << threads << " thread(s) differs from the brute-force distances" << std::endl;
+				failures++;
+			}
+
+			delete distances;
+		}
+	}
+
+	std::cout << failures << " failures in " << masks << " masks" << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+// Compares the union-find region labeling and the region clearing with a brute-force flood fill of the 8-connected regions, and the labeling
+// of parallel row bands with the serial labeling.
+
+// Gives access to the labeling steps of the algorithm
+class LabelingTest : public ColorimetricYCbCrAlgorithm1<unsigned char>
+{
+public:
+
+	void label(const CImg<bool> &mask) { labelRegions(mask); }
+	void clear(CImg<bool> &mask) { deleteMinorRegions(&mask); }
+
+	const CImg<unsigned int>& labels() const { return labelMask; }
+	const std::vector<unsigned int>& sizes() const { return regionSizes; }
+	unsigned int count() const { return regionCount; }
+	unsigned int biggest() const { return biggestRegion; }
+};
+
+// The regions of a mask found by flood fill
+struct Reference
+{
+	CImg<unsigned int> labels; // The region of every pixel (1 to count, 0 = no skin), numbered in raster order of the first pixel
+	std::vector<unsigned int> sizes; // The number of pixels of each region (index 0 is unused)
+	std::vector<unsigned int> lastPixels; // The last pixel in raster order of each region (index 0 is unused)
+};
+
+// Labels the 8-connected regions of the mask with a flood fill
+Reference floodFill(const CImg<bool> &mask)
+{
+	const int width = mask.width(), height = mask.height();
+
+	Reference ref;
+	ref.labels.assign(width,height,1,1,0);
+	ref.sizes.assign(1,0);
+	ref.lastPixels.assign(1,0);
+
+	std::vector<int> stack;
+
+	for (int start = 0; start < width * height; start++)
+	{
+		if (!mask[start] || ref.labels[start] != 0)
+		{
+			continue;
+		}
+
+		const unsigned int label = (unsigned int)ref.sizes.size();
+		ref.sizes.push_back(0);
+		ref.lastPixels.push_back(0);
+
+		ref.labels[start] = label;
+		stack.push_back(start);
+
+		while (!stack.empty())
+		{
+			const int p = stack.back();
+			stack.pop_back();
+
+			ref.sizes[label]++;
+			ref.lastPixels[label] = std::max(ref.lastPixels[label], (unsigned int)p);
+
+			const int x = p % width, y = p / width;
+
+			for (int ny = std::max(0, y - 1); ny <= std::min(height - 1, y + 1); ny++)
+			{
+				for (int nx = std::max(0, x - 1); nx <= std::min(width - 1, x + 1); nx++)
+				{
+					const int q = ny * width + nx;
+
+					if (mask[q] && ref.labels[q] == 0)
+					{
+						ref.labels[q] = label;
+						stack.push_back(q);
+					}
+				}
+			}
+		}
+	}
+
+	return ref;
+}
+
+// Returns the mask after region clearing: only the biggest region is kept, ties go to the region that is complete first in raster order
+CImg<bool> clearReference(const CImg<bool> &mask, const Reference &ref)
+{
+	unsigned int biggest = 0;
+
+	for (unsigned int label = 1; label < ref.sizes.size(); label++)
+	{
+		if (biggest == 0 || ref.sizes[label] > ref.sizes[biggest] || (ref.sizes[label] == ref.sizes[biggest] && ref.lastPixels[label] < ref.lastPixels[biggest]))
+		{
+			biggest = label;
+		}
+	}
+
+	CImg<bool> cleared(mask);
+
+	for (unsigned int p = 0; p < cleared.size(); p++)
+	{
+		cleared[p] = cleared[p] && ref.labels[p] == biggest;
+	}
+
+	return cleared;
+}
+
+// Returns true if the labels of the algorithm describe the same regions as the reference (the labels may be numbered differently)
+bool sameRegions(const LabelingTest &algo, const Reference &ref)
+{
+	const unsigned int count = (unsigned int)ref.sizes.size() - 1;
+
+	if (algo.count() != count || algo.sizes().size() != count + 1)
+	{
+		return false;
+	}
+
+	// Every label has to map to exactly one reference label and the other way round
+	std::vector<unsigned int> toReference(count + 1, 0), fromReference(count + 1, 0);
+
+	for (unsigned int p = 0; p < ref.labels.size(); p++)
+	{
+		const unsigned int label = algo.labels()[p], refLabel = ref.labels[p];
+
+		if ((label == 0) != (refLabel == 0) || label > count)
+		{
+			return false;
+		}
+
+		if (label == 0)
+		{
+			continue;
+		}
+
+		if (toReference[label] == 0 && fromReference[refLabel] == 0)
+		{
+			toReference[label] = refLabel;
+			fromReference[refLabel] = label;
+		}
+		else if (toReference[label] != refLabel || fromReference[refLabel] != label)
+		{
+			return false;
+		}
+	}
+
+	for (unsigned int label = 1; label <= count; label++)
+	{
+		if (algo.sizes()[label] != ref.sizes[toReference[label]])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failures = 0;
+	const unsigned int masks = 300;
+
+	srand(1);
+
+	for (unsigned int m = 0; m < masks; m++)
+	{
+		// Random masks of different sizes and densities, from single pixels to masks that are almost completely skin
+		const int width = 1 + rand() % 90, height = 1 + rand() % 90, density = rand() % 100;
+		CImg<bool> mask(width,height,1,1);
+
+		cimg_forXY(mask,x,y)
+		{
+			mask(x,y) = (rand() % 100) < density;
+		}
+
+		const Reference ref = floodFill(mask);
+		const CImg<bool> cleared = clearReference(mask, ref);
+
+		LabelingTest serial;
+		serial.label(mask);
+
+		if (!sameRegions(serial, ref))
+		{
+			std::cout << "mask " << m << " (" << width << "x" << height << "): the regions differ from the flood fill" << std::endl;
+			failures++;
+		}
+
+		CImg<bool> serialCleared(mask);
+		serial.clear(serialCleared);
+
+		if (serialCleared != cleared)
+		{
+			std::cout << "mask " << m << " (" << width << "x" << height << "): region clearing differs from the flood fill" << std::endl;
+			failures++;
+		}
+
+		for (unsigned int threads = 2; threads <= 4; threads++)
+		{
+			LabelingTest parallel;
+			parallel.ThreadCount(threads);
+			parallel.label(mask);
+
+			CImg<bool> parallelCleared(mask);
+			parallel.clear(parallelCleared);
+
+			if (parallel.labels() != serial.labels() || parallel.sizes() != serial.sizes() || parallel.biggest() != serial.biggest() || parallelCleared != serialCleared)
+			{
+				std::cout << "mask " << m << " (" << width << "x" << height << "): " << threads << " threads differ from the serial labeling" << std::endl;
+				failures++;
+			}
+		}
+	}
+
+	std::cout << failures << " failures in " << masks << " masks" << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
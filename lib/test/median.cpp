@@ -0,0 +1,66 @@
+#include <iostream>
+#include <cstdlib>
+#include <lime/util.hpp>
+#include <lime/Median.hpp>
+#include <lime/ThreadPool.hpp>
+#include <CImg.h>
+
+using namespace lime;
+using namespace cimg_library;
+
+// Compares median::blurMedian with CImg::get_blur_median for the kernel sizes 1 to 11 (n = 5 repeats the border of the image, all other sizes
+// clip the window at the border) on images that are narrower and wider than the 128 column strips of the histogram filter, serially with
+// reused buffers and with the strips filtered on a thread pool.
+
+int main(int argc, char** argv)
+{
+	const int widths[] = { 1, 2, 5, 127, 128, 129, 255, 256, 300 };
+	const int heights[] = { 1, 2, 3, 4, 7, 12, 25 };
+
+	ThreadPool pool(3);
+	median::Buffers buffers;
+	unsigned int failures = 0, runs = 0;
+
+	srand(1);
+
+	for (unsigned int n = 1; n <= 11; n++)
+	{
+		for (unsigned int w = 0; w < sizeof(widths) / sizeof(widths[0]); w++)
+		{
+			for (unsigned int h = 0; h < sizeof(heights) / sizeof(heights[0]); h++)
+			{
+				// Smooth gradients with impulse noise, so the medians differ from the pixels
+				CImg<unsigned char> img(widths[w],heights[h],1,3);
+
+				cimg_forXYC(img,x,y,c)
+				{
+					img(x,y,0,c) = (unsigned char)(((rand() % 4) == 0) ? rand() % 256 : (x * 3 + y * 5 + c * 70) % 256);
+				}
+
+				const CImg<unsigned char> expected = img.get_blur_median(n);
+
+				CImg<unsigned char> serial, parallel;
+				median::blurMedian(img, n, serial, 0, &buffers);
+				median::blurMedian(img, n, parallel, &pool);
+
+				if (serial != expected)
+				{
+					std::cout << "n " << n << ", " << img.width() << "x" << img.height() << ": the serial filter differs from CImg" << std::endl;
+					failures++;
+				}
+
+				if (parallel != serial)
+				{
+					std::cout << "n " << n << ", " << img.width() << "x" << img.height() << ": the parallel filter differs from the serial one" << std::endl;
+					failures++;
+				}
+
+				runs++;
+			}
+		}
+	}
+
+	std::cout << failures << " failures in " << runs << " images" << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
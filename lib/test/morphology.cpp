@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cstdlib>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <lime/Morphology.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+// Compares the van Herk / Gil-Werman erosion and dilation (morphology::erode / dilate) and the grow and shrink algorithms on the packed mask
+// (BinaryMask) with CImg::erode / dilate applied count times, for odd and even kernel sizes. Only images that pass morphology::matchesCImg are
+// compared: for kernels that are at least as big as the image CImg reads outside of the image, so its result is not defined, and the grow and
+// shrink algorithms call CImg themselves.
+
+// Gives access to the grow and shrink algorithms
+class MorphologyTest : public ColorimetricYCbCrAlgorithm1<unsigned char>
+{
+public:
+
+	void grow(CImg<bool> &mask, unsigned int count, unsigned int size) { growAlgorithm(&mask, count, size); }
+	void shrink(CImg<bool> &mask, unsigned int count, unsigned int size) { shrinkAlgorithm(&mask, count, size); }
+};
+
+// Returns the image after count dilations (or erosions) by CImg
+template<typename T>
+CImg<T> reference(const CImg<T> &img, bool dilate, unsigned int count, unsigned int size)
+{
+	CImg<T> res(img);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (dilate)
+		{
+			res.dilate(size);
+		}
+		else
+		{
+			res.erode(size);
+		}
+	}
+
+	return res;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int failures = 0, tests = 0, skipped = 0;
+
+	srand(1);
+
+	for (unsigned int t = 0; t < 3000; t++)
+	{
+		// Random masks from 1x1 to 70x70 (wider than a 64 bit word of the packed mask), kernel sizes 1 to 9 and 1 to 3 repetitions
+		const int width = 1 + rand() % 70, height = 1 + rand() % 70, density = rand() % 100;
+		const unsigned int size = 1 + rand() % 9, count = 1 + rand() % 3;
+		const bool dilate = (t % 2) == 0;
+
+		CImg<bool> mask(width,height,1,1);
+
+		cimg_forXY(mask,x,y)
+		{
+			mask(x,y) = (rand() % 100) < density;
+		}
+
+		if (!morphology::matchesCImg(mask, size))
+		{
+			skipped++;
+			continue;
+		}
+
+		const CImg<bool> expected = reference(mask, dilate, count, size);
+
+		CImg<bool> filtered(mask);
+
+		if (dilate)
+		{
+			morphology::dilate(filtered, size, count);
+		}
+		else
+		{
+			morphology::erode(filtered, size, count);
+		}
+
+		MorphologyTest algo;
+		CImg<bool> packed(mask);
+
+		if (dilate)
+		{
+			algo.grow(packed, count, size);
+		}
+		else
+		{
+			algo.shrink(packed, count, size);
+		}
+
+		// The generic filters also handle other data types and several channels
+		CImg<unsigned char> gray(width,height,1,2);
+
+		cimg_forXYC(gray,x,y,c)
+		{
+			gray(x,y,0,c) = (unsigned char)(rand() % 256);
+		}
+
+		const CImg<unsigned char> grayExpected = reference(gray, dilate, count, size);
+
+		if (dilate)
+		{
+			morphology::dilate(gray, size, count);
+		}
+		else
+		{
+			morphology::erode(gray, size, count);
+		}
+
+		const char *name = dilate ? "dilate" : "erode";
+
+		if (filtered != expected)
+		{
+			std::cout << "morphology::" << name << " " << width << "x" << height << ", size " << size << ", count " << count << " differs from CImg" << std::endl;
+			failures++;
+		}
+
+		if (packed != expected)
+		{
+			std::cout << (dilate ? "growAlgorithm " : "shrinkAlgorithm ") << width << "x" << height << ", size " << size << ", count " << count << " differs from CImg" << std::endl;
+			failures++;
+		}
+
+		if (gray != grayExpected)
+		{
+			std::cout << "morphology::" << name << " (unsigned char) " << width << "x" << height << ", size " << size << ", count " << count << " differs from CImg" << std::endl;
+			failures++;
+		}
+
+		tests += 3;
+	}
+
+	std::cout << failures << " of " << tests << " results differ from CImg (" << skipped << " images skipped)" << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
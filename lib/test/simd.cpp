@@ -0,0 +1,150 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+
+using namespace lime;
+
+// Compares the vectorized YCbCr classification of 8-bit rows with the scalar transformPixel and skinThresholds. The instruction set of the
+// kernel is chosen at compile time, so this test is built once with the default flags (SSE2 on x86) and once with AVX2 (see CMakeLists.txt).
+
+// Exit code that tells CTest that the test was skipped
+static const int skipped = 77;
+
+// Gives access to the classification steps of the algorithm
+class YCbCrTest : public ColorimetricYCbCrAlgorithm1<unsigned char>
+{
+public:
+
+	bool classifyPixel(unsigned char r, unsigned char g, unsigned char b)
+	{
+		double c1,c2,c3;
+		transformPixel(r,g,b,c1,c2,c3);
+
+		return skinThresholds(c1,c2,c3);
+	}
+
+	void classify(const unsigned char *r, const unsigned char *g, const unsigned char *b, unsigned int count, bool *mask)
+	{
+		classifyRow(r,g,b,count,mask);
+	}
+};
+
+// Classifies all 2^24 colors (one row of 256 blue values per red and green value) and returns the number of differences
+unsigned int testAllColors(YCbCrTest &algo)
+{
+	std::vector<unsigned char> r(256), g(256), b(256);
+	bool mask[256];
+	unsigned int differences = 0;
+
+	for (int i = 0; i < 256; i++)
+	{
+		b[i] = (unsigned char)i;
+	}
+
+	for (int red = 0; red < 256; red++)
+	{
+		for (int green = 0; green < 256; green++)
+		{
+			std::fill(r.begin(), r.end(), (unsigned char)red);
+			std::fill(g.begin(), g.end(), (unsigned char)green);
+
+			algo.classify(r.data(), g.data(), b.data(), 256, mask);
+
+			for (int blue = 0; blue < 256; blue++)
+			{
+				differences += (mask[blue] != algo.classifyPixel((unsigned char)red, (unsigned char)green, (unsigned char)blue)) ? 1 : 0;
+			}
+		}
+	}
+
+	return differences;
+}
+
+// Classifies rows of every length from 0 to 95 (every tail width of the 16 and 32 pixel loops) at different offsets and returns the number of
+// differences. Pixels behind the end of a row must not be written.
+unsigned int testTails(YCbCrTest &algo)
+{
+	const unsigned int maxCount = 96, maxOffset = 4;
+	std::vector<unsigned char> r(maxCount + maxOffset), g(maxCount + maxOffset), b(maxCount + maxOffset);
+	bool mask[maxCount + 1];
+	unsigned int differences = 0;
+
+	srand(1);
+
+	for (unsigned int offset = 0; offset < maxOffset; offset++)
+	{
+		for (unsigned int count = 0; count < maxCount; count++)
+		{
+			// Half of the pixels are taken from the range of typical skin colors, so both results occur
+			for (unsigned int i = 0; i < r.size(); i++)
+			{
+				const bool skinLike = (rand() % 2) == 0;
+				r[i] = (unsigned char)(skinLike ? 150 + rand() % 106 : rand() % 256);
+				g[i] = (unsigned char)(skinLike ? 90 + rand() % 100 : rand() % 256);
+				b[i] = (unsigned char)(skinLike ? 70 + rand() % 100 : rand() % 256);
+			}
+
+			mask[count] = true;
+			algo.classify(r.data() + offset, g.data() + offset, b.data() + offset, count, mask);
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				differences += (mask[i] != algo.classifyPixel(r[offset + i], g[offset + i], b[offset + i])) ? 1 : 0;
+			}
+
+			differences += mask[count] ? 0 : 1;
+		}
+	}
+
+	return differences;
+}
+
+int main(int argc, char** argv)
+{
+#if defined(LIME_SIMD_AVX2)
+	const char *instructionSet = "AVX2";
+
+#if defined(__GNUC__)
+	if (!__builtin_cpu_supports("avx2"))
+	{
+		std::cout << "AVX2 is not supported by this CPU, skipped" << std::endl;
+		return skipped;
+	}
+#endif
+#elif defined(LIME_SIMD_SSE2)
+	const char *instructionSet = "SSE2";
+#else
+	const char *instructionSet = "scalar";
+#endif
+
+	// The default thresholds, fractional thresholds, thresholds outside of [0,255] and empty ranges
+	const Threshold thresholds[][4] = {
+		{ 77.0, 127.0, 133.0, 173.0 },
+		{ 80.5, 120.2, 140.7, 165.3 },
+		{ 0.0, 255.0, 0.0, 255.0 },
+		{ -5.0, 300.0, 100.0, 100.0 },
+		{ 100.5, 0.5, 120.0, 180.0 },
+		{ 100.0, -1.0, 120.0, 180.0 } };
+
+	unsigned int failures = 0;
+
+	for (unsigned int t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++)
+	{
+		YCbCrTest algo;
+		algo.Cb_lower(thresholds[t][0]);
+		algo.Cb_higher(thresholds[t][1]);
+		algo.Cr_lower(thresholds[t][2]);
+		algo.Cr_higher(thresholds[t][3]);
+
+		const unsigned int colorDifferences = testAllColors(algo);
+		const unsigned int tailDifferences = testTails(algo);
+
+		std::cout << instructionSet << " thresholds " << t << ": " << colorDifferences << " of 2^24 colors and " << tailDifferences
+			<< " tail pixels differ" << std::endl;
+
+		failures += colorDifferences + tailDifferences;
+	}
+
+	return (failures == 0) ? 0 : 1;
+}
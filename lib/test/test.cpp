@@ -1,9 +1,9 @@
 #include <iostream>
-#include <CImg.h>
 #include <lime/Segmentation.hpp>
 #include <lime/ColorimetricHSIAlgorithm1.hpp>
 #include <lime/ColorimetricYCbCrAlgorithm1.hpp>
 #include <lime/ColorimetricHSVAlgorithm1.hpp>
+#include <CImg.h>
 
 using namespace lime;
 
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <lime/Segmentation.hpp>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+// Checks that the YCbCr algorithm rejects colors whose Cb lies outside of [Cb_lower,Cb_higher]. The check used to be the chained expression
+// cb_lower <= c2 <= cb_higher, which is always true for the default thresholds, so only Cr decided.
+
+// The colors of the test image (Cb and Cr with the default thresholds [77,127] and [133,173]) and if they are skin
+static const unsigned char colors[][3] = {
+	{ 200, 140, 110 },	// Cb 106, Cr 156: skin
+	{ 255, 200, 0 },	// Cb 32, Cr 166: Cb below the range
+	{ 180, 100, 250 },	// Cb 182, Cr 152: Cb above the range
+	{ 40, 160, 90 } };	// Cb 115, Cr 80: Cr below the range
+
+static const bool expected[] = { true, false, false, false };
+
+// Segments the test image with every classification path of the pixel type T and returns the number of wrongly classified pixels
+template<typename T>
+unsigned int testThresholds(const char *name)
+{
+	const unsigned int count = sizeof(expected) / sizeof(expected[0]);
+
+	CImg<T> img(count,1,1,3);
+
+	for (unsigned int x = 0; x < count; x++)
+	{
+		for (unsigned int c = 0; c < 3; c++)
+		{
+			img(x,0,0,c) = (T)colors[x][c];
+		}
+	}
+
+	unsigned int failures = 0;
+
+	for (int lookupTable = 0; lookupTable < 2; lookupTable++)
+	{
+		ColorimetricYCbCrAlgorithm1<T> algo;
+		algo.ApplyLookupTable(lookupTable != 0);
+
+		Segmentation<T> segm(&algo);
+		CImg<bool> mask;
+		segm.retrieveMask_asBinaryChannel(img,mask);
+
+		for (unsigned int x = 0; x < count; x++)
+		{
+			if (mask(x,0) != expected[x])
+			{
+				std::cout << name << (lookupTable ? " with lookup table" : "") << ": color " << x << " is " << (mask(x,0) ? "skin" : "no skin") << std::endl;
+				failures++;
+			}
+		}
+	}
+
+	return failures;
+}
+
+int main(int argc, char** argv)
+{
+	const unsigned int failures = testThresholds<unsigned char>("unsigned char") + testThresholds<float>("float") + testThresholds<double>("double");
+
+	std::cout << failures << " wrongly classified pixels" << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <cstdlib>
+#include <lime/BatchSegmentation.hpp>
+#include <lime/ColorimetricYCbCrAlgorithm1.hpp>
+#include <CImg.h>
+
+using namespace lime;
+
+typedef unsigned char NumType;
+
+// Segments every image listed in a text file (one path per line) and stores the masks as <output directory>/<index>_<image name>.bmp, where index is
+// the position of the image in the list. The index keeps the names of images with the same file name (e.g. a/x.jpg and b/x.jpg, or x.jpg and
+// x.png) apart, so their masks do not overwrite each other.
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cerr << "usage: " << argv[0] << " <list of images> <output directory> [threads]" << std::endl;
+		return 1;
+	}
+
+	std::vector<std::string> paths;
+	std::map<std::string, std::size_t> indices;
+	std::ifstream list(argv[1]);
+	std::string line;
+
+	while (std::getline(list, line))
+	{
+		if (line.empty())
+		{
+			continue;
+		}
+
+		// A path that is listed twice is the same image, it is segmented once
+		if (indices.count(line))
+		{
+			std::cerr << "listed twice: " << line << std::endl;
+			continue;
+		}
+
+		indices[line] = paths.size();
+		paths.push_back(line);
+	}
+
+	const std::string outputDir = argv[2];
+	const unsigned int threads = (argc > 3) ? (unsigned int)std::atoi(argv[3]) : 0;
+
+	// Algorithm configuration
+	ColorimetricYCbCrAlgorithm1<NumType> algo = ColorimetricYCbCrAlgorithm1<NumType>();
+	algo.ApplyMedian(true);
+	algo.MedianSize(3);
+	algo.ApplyRegionClearing(true);
+	algo.ApplyLookupTable(true);
+	algo.ThreadCount(threads);
+
+	// Decoding and encoding run on their own threads while the algorithm segments
+	BatchSegmentation<NumType> batch(&algo, 4, 2, 2);
+
+	const unsigned int done = batch.process(paths, [&](const std::string &path, const CImg<bool> &mask)
+	{
+		const std::string::size_type slash = path.find_last_of("/\\");
+		const std::string file = (slash == std::string::npos) ? path : path.substr(slash + 1);
+
+		std::ostringstream name;
+		name << indices.find(path)->second << "_" << file.substr(0, file.find_last_of('.')) << ".bmp";
+
+		CImg<unsigned char> out(mask);
+		out *= 255;
+		out.save((outputDir + "/" + name.str()).c_str());
+	});
+
+	for (unsigned int i = 0; i < batch.Failures().size(); i++)
+	{
+		std::cerr << "failed: " << batch.Failures()[i] << std::endl;
+	}
+
+	std::cout << done << " of " << paths.size() << " images segmented" << std::endl;
+
+	return batch.Failures().empty() ? 0 : 2;
+}